@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -210,18 +211,23 @@ namespace Dune
       Phase phase_;
       int coarsenMarked_;
       int refineMarked_;
+      int coarsenLevel_;
 
     public:
       AdaptationState ()
         : phase_( ComputationPhase ),
           coarsenMarked_( 0 ),
-          refineMarked_( 0 )
+          refineMarked_( 0 ),
+          coarsenLevel_( std::numeric_limits< int >::max() )
       {}
 
-      void mark ( int count )
+      void mark ( int count, int level )
       {
         if( count < 0 )
+        {
           ++coarsenMarked_;
+          coarsenLevel_ = std::min( coarsenLevel_, level );
+        }
         if( count > 0 )
           refineMarked_ += (2 << count);
       }
@@ -244,6 +250,12 @@ namespace Dune
         return refineMarked_;
       }
 
+      //! coarsest level of the elements marked for coarsening (elements unmarked again are not removed)
+      int coarsenLevel () const
+      {
+        return coarsenLevel_;
+      }
+
       void preAdapt ()
       {
         if( phase_ != ComputationPhase )
@@ -266,6 +278,7 @@ namespace Dune
 
         coarsenMarked_ = 0;
         refineMarked_ = 0;
+        coarsenLevel_ = std::numeric_limits< int >::max();
       }
 
     private:
@@ -543,7 +556,8 @@ namespace Dune
 
     // make the calculation of indexOnLevel and so on.
     // extra method because of Reihenfolge
-    void calcExtras();
+    // the sizes of the levels coarser than minLevel are kept, as these levels did not change
+    void calcExtras( int minLevel = 0 );
 
   private:
     // delete mesh and all vectors
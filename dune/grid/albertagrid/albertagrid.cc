@@ -394,7 +394,7 @@ namespace Dune
     adaptationState_.unmark( getMark( e ) );
 
     // set new marking
-    adaptationState_.mark( refCount );
+    adaptationState_.mark( refCount, e.level() );
     getRealImplementation( e ).elementInfo().setMark( refCount );
 
     return true;
@@ -422,8 +422,9 @@ namespace Dune
     adaptationState_.adapt();
     hIndexSet_.postAdapt();
 
+    // only the levels of new and removed elements have changed
     if( refined || coarsened )
-      calcExtras();
+      calcExtras( std::min( int( levelProvider_.minNewLevel() ), adaptationState_.coarsenLevel() ) );
 
     // return true if elements were created
     return refined;
@@ -542,7 +543,7 @@ namespace Dune
 
 
   template < int dim, int dimworld >
-  inline void AlbertaGrid < dim, dimworld >::calcExtras ()
+  inline void AlbertaGrid < dim, dimworld >::calcExtras ( int minLevel )
   {
     // determine new maxlevel
     maxlevel_ = levelProvider_.maxLevel();
@@ -555,7 +556,7 @@ namespace Dune
     // unset up2Dat status, if leafbegin is called then this status is updated
     leafMarkerVector_.clear();
 
-    sizeCache_.reset();
+    sizeCache_.reset( minLevel );
 
     // update index sets (if they exist)
     if( leafIndexSet_ != 0 )
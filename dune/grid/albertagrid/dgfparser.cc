@@ -18,13 +18,13 @@ namespace Dune
   // ------------------------------------------------
 
   template< int dim, int dimworld >
-  bool DGFGridFactory< AlbertaGrid< dim, dimworld > >::generate( std::istream &input )
+  bool DGFGridFactory< AlbertaGrid< dim, dimworld > >::generate( std::istream &input, const DuneGridFormatParser::Cache &cache )
   {
     dgf_.element = DuneGridFormatParser::Simplex;
     dgf_.dimgrid = dim;
     dgf_.dimw = dimworld;
 
-    if( !dgf_.readDuneGrid( input, dim, dimworld ) )
+    if( !dgf_.readDuneGrid( input, dim, dimworld, cache ) )
       return false;
 
     for( int n = 0; n < dgf_.nofvtx; ++n )
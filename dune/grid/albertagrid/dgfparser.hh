@@ -43,7 +43,8 @@ namespace Dune
     explicit DGFGridFactory ( std::istream &input,
                               MPICommunicatorType comm = MPIHelper::getCommunicator() );
     explicit DGFGridFactory ( const std::string &filename,
-                              MPICommunicatorType comm = MPIHelper::getCommunicator() );
+                              MPICommunicatorType comm = MPIHelper::getCommunicator(),
+                              const DuneGridFormatParser::Cache &cache = DuneGridFormatParser::Cache() );
 
     Grid *grid () const
     {
@@ -126,7 +127,7 @@ namespace Dune
     }
 
   private:
-    bool generate( std::istream &input );
+    bool generate( std::istream &input, const DuneGridFormatParser::Cache &cache = DuneGridFormatParser::Cache() );
 
     Grid *grid_;
     GridFactory factory_;
@@ -172,13 +173,13 @@ namespace Dune
 
   template< int dim, int dimworld >
   inline DGFGridFactory< AlbertaGrid< dim, dimworld > >
-  ::DGFGridFactory ( const std::string &filename, MPICommunicatorType comm )
+  ::DGFGridFactory ( const std::string &filename, MPICommunicatorType comm, const DuneGridFormatParser::Cache &cache )
     : dgf_( 0, 1 )
   {
     std::ifstream input( filename.c_str() );
     if( !input )
       DUNE_THROW( DGFException, "Macrofile " << filename << " not found." );
-    if( !generate( input ) )
+    if( !generate( input, cache ) )
       grid_ = new AlbertaGrid< dim, dimworld >( filename.c_str() );
     input.close();
   }
@@ -117,6 +117,25 @@ namespace Dune
       macroData_.insertVertex( pos );
     }
 
+    /** \brief insert several vertices into the macro grid
+     *
+     *  \param[in]  coordinates  coordinates of the vertices, dimensionworld consecutive values per vertex
+     */
+    virtual void insertVertices ( const std::vector< ctype > &coordinates )
+    {
+      if( coordinates.size() % dimensionworld != 0 )
+        DUNE_THROW( AlbertaError, "Number of coordinates is not a multiple of the world dimension: " << coordinates.size() << "." );
+
+      macroData_.reserve( macroData_.vertexCount() + coordinates.size() / dimensionworld, macroData_.elementCount() );
+      WorldVector pos;
+      for( std::size_t i = 0; i < coordinates.size(); i += dimensionworld )
+      {
+        for( int k = 0; k < dimensionworld; ++k )
+          pos[ k ] = coordinates[ i+k ];
+        macroData_.insertVertex( pos );
+      }
+    }
+
     /** \brief insert an element into the macro grid
      *
      *  \param[in]  type      GeometryType of the new element
@@ -125,18 +144,49 @@ namespace Dune
     virtual void insertElement ( const GeometryType &type,
                                  const std::vector< unsigned int > &vertices )
     {
-      if( (int)type.dim() != dimension )
-        DUNE_THROW( AlbertaError, "Inserting element of wrong dimension: " << type.dim() );
-      if( !type.isSimplex() )
-        DUNE_THROW( AlbertaError, "Alberta supports only simplices." );
-
+      checkType( type );
       if( vertices.size() != (size_t)numVertices )
         DUNE_THROW( AlbertaError, "Wrong number of vertices passed: " << vertices.size() << "." );
 
-      int array[ numVertices ];
-      for( int i = 0; i < numVertices; ++i )
-        array[ i ] = vertices[ numberingMap_.alberta2dune( dimension, i ) ];
-      macroData_.insertElement( array );
+      insertSimplex( vertices.data() );
+    }
+
+    /** \brief insert several elements of the same type into the macro grid
+     *
+     *  \param[in]  type      GeometryType of the new elements
+     *  \param[in]  vertices  indices of the element vertices (in DUNE numbering)
+     */
+    virtual void insertElements ( const GeometryType &type,
+                                  const std::vector< unsigned int > &vertices )
+    {
+      checkType( type );
+      if( vertices.size() % numVertices != 0 )
+        DUNE_THROW( AlbertaError, "Wrong number of vertices passed: " << vertices.size() << "." );
+
+      macroData_.reserve( macroData_.vertexCount(), macroData_.elementCount() + vertices.size() / numVertices );
+      for( std::size_t i = 0; i < vertices.size(); i += numVertices )
+        insertSimplex( vertices.data() + i );
+    }
+
+    /** \brief insert several elements into the macro grid
+     *
+     *  \param[in]  types     GeometryTypes of the new elements
+     *  \param[in]  offsets   offsets of the vertices of each element (CSR format)
+     *  \param[in]  vertices  indices of the element vertices (in DUNE numbering)
+     */
+    virtual void insertElements ( const std::vector< GeometryType > &types,
+                                  const std::vector< unsigned int > &offsets,
+                                  const std::vector< unsigned int > &vertices )
+    {
+      this->checkOffsets( types, offsets, vertices );
+      for( std::size_t i = 0; i < types.size(); ++i )
+      {
+        checkType( types[ i ] );
+        if( offsets[ i+1 ] - offsets[ i ] != (unsigned int)numVertices )
+          DUNE_THROW( AlbertaError, "Wrong number of vertices passed: " << offsets[ i+1 ] - offsets[ i ] << "." );
+      }
+
+      insertElements( types.empty() ? GeometryType( GeometryType::simplex, dimension ) : types.front(), vertices );
     }
 
     /** \brief mark a face as boundary (and assign a boundary id)
@@ -357,6 +407,22 @@ namespace Dune
     }
 
   private:
+    void checkType ( const GeometryType &type ) const
+    {
+      if( (int)type.dim() != dimension )
+        DUNE_THROW( AlbertaError, "Inserting element of wrong dimension: " << type.dim() );
+      if( !type.isSimplex() )
+        DUNE_THROW( AlbertaError, "Alberta supports only simplices." );
+    }
+
+    void insertSimplex ( const unsigned int *vertices )
+    {
+      int array[ numVertices ];
+      for( int i = 0; i < numVertices; ++i )
+        array[ i ] = vertices[ numberingMap_.alberta2dune( dimension, i ) ];
+      macroData_.insertElement( array );
+    }
+
     unsigned int insertionIndex ( const ElementInfo &elementInfo ) const;
     unsigned int insertionIndex ( const ElementInfo &elementInfo, const int face ) const;
 
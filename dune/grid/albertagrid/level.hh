@@ -35,6 +35,7 @@ namespace Dune
 
     class SetLocal;
     class CalcMaxLevel;
+    class CalcMinNewLevel;
 
     template< Level flags >
     struct ClearFlags;
@@ -80,6 +81,14 @@ namespace Dune
       return calcFromCache.maxLevel();;
     }
 
+    //! coarsest level of the elements created since markAllOld, or levelMask if there are none
+    Level minNewLevel () const
+    {
+      CalcMinNewLevel calcMinNewLevel;
+      level_.forEach( calcMinNewLevel );
+      return calcMinNewLevel.minNewLevel();
+    }
+
     MeshPointer mesh () const
     {
       return MeshPointer( level_.dofSpace()->mesh );
@@ -172,6 +181,33 @@ namespace Dune
 
 
 
+  // AlbertaGridLevelProvider::CalcMinNewLevel
+  // -----------------------------------------
+
+  template< int dim >
+  class AlbertaGridLevelProvider< dim >::CalcMinNewLevel
+  {
+    Level minNewLevel_;
+
+  public:
+    CalcMinNewLevel ()
+      : minNewLevel_( levelMask )
+    {}
+
+    void operator() ( const Level &dof )
+    {
+      if( (dof & isNewFlag) != 0 )
+        minNewLevel_ = std::min( minNewLevel_, Level( dof & levelMask ) );
+    }
+
+    Level minNewLevel () const
+    {
+      return minNewLevel_;
+    }
+  };
+
+
+
   // AlbertaGridLevelProvider::ClearFlags
   // ------------------------------------
 
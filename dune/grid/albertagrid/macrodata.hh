@@ -167,6 +167,21 @@ namespace Dune
         return vertexCount_++;
       }
 
+      /** \brief reserve space for vertices and elements
+       *
+       *  Make sure that the given total numbers of vertices and elements can
+       *  be inserted without reallocation. This may only be done in insert
+       *  mode.
+       */
+      void reserve ( int numVertices, int numElements )
+      {
+        assert( (vertexCount_ >= 0) && (elementCount_ >= 0) );
+        if( numVertices > data_->n_total_vertices )
+          resizeVertices( numVertices );
+        if( numElements > data_->n_macro_elements )
+          resizeElements( numElements );
+      }
+
       void insertWallTrafo ( const GlobalMatrix &m, const GlobalVector &t );
       void insertWallTrafo ( const FieldMatrix< Real, dimWorld, dimWorld > &matrix,
                              const FieldVector< Real, dimWorld > &shift );
@@ -11,6 +11,7 @@
 
 #include <dune/common/fmatrix.hh>
 #include <dune/common/typetraits.hh>
+#include <dune/common/typeutilities.hh>
 
 #include <dune/geometry/referenceelements.hh>
 
@@ -168,6 +169,37 @@ namespace Dune
       return impl().local( global );
     }
 
+    /** \brief Evaluate the map \f$ g\f$ for a whole set of points
+     *
+     *  The result is the same as calling global() for every entry of
+     *  \a local, but implementations may map all points at once, e.g., all
+     *  points of a quadrature rule.  Implementations not providing such a
+     *  batched version fall back to the pointwise evaluation.
+     *
+     *  \param[in]  local   random access container of LocalCoordinate
+     *  \param[out] global  random access container of GlobalCoordinate, at least as large as \a local
+     */
+    template< class LocalContainer, class GlobalContainer >
+    void global ( const LocalContainer &local, GlobalContainer &global ) const
+    {
+      assert( global.size() >= local.size() );
+      globalBatch( impl(), local, global, PriorityTag< 1 >() );
+    }
+
+    /** \brief Evaluate the inverse map \f$ g^{-1}\f$ for a whole set of points
+     *
+     *  \param[in]  global  random access container of GlobalCoordinate
+     *  \param[out] local   random access container of LocalCoordinate, at least as large as \a global
+     *
+     *  \sa global( const LocalContainer &, GlobalContainer & ) const
+     */
+    template< class GlobalContainer, class LocalContainer >
+    void local ( const GlobalContainer &global, LocalContainer &local ) const
+    {
+      assert( local.size() >= global.size() );
+      localBatch( impl(), global, local, PriorityTag< 1 >() );
+    }
+
     /** \brief Return the factor appearing in the integral transformation formula
 
        Let \f$ g : D \to W\f$ denote the transformation described by the Geometry.
@@ -275,6 +307,35 @@ namespace Dune
     /** hide assignment operator */
     const Geometry &operator= ( const Geometry &rhs );
 
+    // use the batched evaluation of the implementation, if there is one
+    template< class Impl, class LocalContainer, class GlobalContainer >
+    static auto globalBatch ( const Impl &geo, const LocalContainer &local, GlobalContainer &global, PriorityTag< 1 > )
+      -> decltype( geo.global( local, global ), void() )
+    {
+      geo.global( local, global );
+    }
+
+    template< class Impl, class LocalContainer, class GlobalContainer >
+    static void globalBatch ( const Impl &geo, const LocalContainer &local, GlobalContainer &global, PriorityTag< 0 > )
+    {
+      for( std::size_t q = 0; q < local.size(); ++q )
+        global[ q ] = geo.global( local[ q ] );
+    }
+
+    template< class Impl, class GlobalContainer, class LocalContainer >
+    static auto localBatch ( const Impl &geo, const GlobalContainer &global, LocalContainer &local, PriorityTag< 1 > )
+      -> decltype( geo.local( global, local ), void() )
+    {
+      geo.local( global, local );
+    }
+
+    template< class Impl, class GlobalContainer, class LocalContainer >
+    static void localBatch ( const Impl &geo, const GlobalContainer &global, LocalContainer &local, PriorityTag< 0 > )
+    {
+      for( std::size_t q = 0; q < global.size(); ++q )
+        local[ q ] = geo.local( global[ q ] );
+    }
+
   protected:
 
     Implementation realGeometry;
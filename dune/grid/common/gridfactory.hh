@@ -7,12 +7,14 @@
     \brief Provide a generic factory class for unstructured grids.
  */
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include <dune/common/function.hh>
 #include <dune/common/fvector.hh>
 
+#include <dune/geometry/referenceelements.hh>
 #include <dune/geometry/type.hh>
 
 #include <dune/grid/common/boundarysegment.hh>
@@ -111,6 +113,80 @@ namespace Dune
     virtual void insertElement(const GeometryType& type,
                                const std::vector<unsigned int>& vertices) = 0;
 
+    /** \brief Insert several vertices into the coarse grid
+        \param coordinates The coordinates of the vertices, dimworld consecutive values per vertex
+
+        The vertices get consecutive insertion indices, as if they were inserted
+        one by one by insertVertex.  The default implementation does just that;
+        grid factories may override it to avoid the overhead per vertex.
+     */
+    virtual void insertVertices(const std::vector<ctype>& coordinates)
+    {
+      if (coordinates.size() % dimworld != 0)
+        DUNE_THROW(GridError, "The number of coordinates " << coordinates.size()
+                   << " is not a multiple of the world dimension " << int(dimworld) << "!");
+
+      FieldVector<ctype,dimworld> pos;
+      for (std::size_t i = 0; i < coordinates.size(); i += dimworld)
+      {
+        for (int k = 0; k < dimworld; ++k)
+          pos[k] = coordinates[i+k];
+        insertVertex(pos);
+      }
+    }
+
+    /** \brief Insert several elements of the same type into the coarse grid
+        \param type The GeometryType of the new elements
+        \param vertices The vertices of the new elements, using the DUNE numbering,
+                        the corners of each element are stored consecutively
+
+        The elements get consecutive insertion indices, as if they were inserted
+        one by one by insertElement.  The default implementation does just that;
+        grid factories may override it to avoid the overhead per element.
+     */
+    virtual void insertElements(const GeometryType& type,
+                                const std::vector<unsigned int>& vertices)
+    {
+      if ((int)type.dim() != dimension)
+        DUNE_THROW(GridError, "You cannot insert a " << type << " into a grid of dimension " << dimension << "!");
+
+      const std::size_t numCorners = ReferenceElements<ctype,dimension>::general(type).size(dimension);
+      if (vertices.size() % numCorners != 0)
+        DUNE_THROW(GridError, "The number of vertices " << vertices.size()
+                   << " is not a multiple of the number of corners of a " << type << "!");
+
+      std::vector<unsigned int> corners(numCorners);
+      for (std::size_t i = 0; i < vertices.size(); i += numCorners)
+      {
+        std::copy(vertices.begin() + i, vertices.begin() + i + numCorners, corners.begin());
+        insertElement(type, corners);
+      }
+    }
+
+    /** \brief Insert several elements of possibly different types into the coarse grid
+        \param types The GeometryTypes of the new elements
+        \param offsets Offsets into vertices (CSR format): the vertices of element i
+                       are vertices[offsets[i]], ..., vertices[offsets[i+1]-1]
+        \param vertices The vertices of the new elements, using the DUNE numbering
+
+        The elements get consecutive insertion indices, as if they were inserted
+        one by one by insertElement.  The default implementation does just that;
+        grid factories may override it to avoid the overhead per element.
+     */
+    virtual void insertElements(const std::vector<GeometryType>& types,
+                                const std::vector<unsigned int>& offsets,
+                                const std::vector<unsigned int>& vertices)
+    {
+      checkOffsets(types, offsets, vertices);
+
+      std::vector<unsigned int> corners;
+      for (std::size_t i = 0; i < types.size(); ++i)
+      {
+        corners.assign(vertices.begin() + offsets[i], vertices.begin() + offsets[i+1]);
+        insertElement(types[i], corners);
+      }
+    }
+
     /** \brief Insert a parametrized element into the coarse grid
         \param type The GeometryType of the new element
         \param vertices The vertices of the new element, using the DUNE numbering
@@ -247,6 +323,19 @@ namespace Dune
       DUNE_THROW( NotImplemented, "insertion indices have not yet been implemented." );
     }
 
+  protected:
+    /** \brief check the offsets passed to insertElements */
+    static void checkOffsets (const std::vector<GeometryType>& types,
+                              const std::vector<unsigned int>& offsets,
+                              const std::vector<unsigned int>& vertices)
+    {
+      if (offsets.size() != types.size() + 1)
+        DUNE_THROW(GridError, "There have to be " << types.size() + 1 << " offsets for "
+                   << types.size() << " elements, but there are " << offsets.size() << "!");
+      if (offsets.front() != 0 || offsets.back() != vertices.size() || !std::is_sorted(offsets.begin(), offsets.end()))
+        DUNE_THROW(GridError, "The offsets do not describe the " << vertices.size() << " vertices!");
+    }
+
   };
 
 
@@ -4,17 +4,22 @@
 #ifndef DUNE_GRID_COMMON_MCMGMAPPER_HH
 #define DUNE_GRID_COMMON_MCMGMAPPER_HH
 
+#include <cassert>
 #include <functional>
 #include <iostream>
+#include <vector>
 
 #include <dune/common/deprecated.hh>
 #include <dune/common/exceptions.hh>
+#include <dune/common/iteratorrange.hh>
 #include <dune/geometry/dimension.hh>
 #include <dune/geometry/referenceelements.hh>
 #include <dune/geometry/type.hh>
 #include <dune/geometry/typeindex.hh>
 
+#include "capabilities.hh"
 #include "mapper.hh"
+#include "rangegenerators.hh"
 
 /**
  * @file
@@ -87,6 +92,22 @@ namespace Dune
         { DUNE_THROW(Exception, "The default layout class cannot be used"); }
     };
 
+    /*
+     * Whether each codimension of the grid view GV has a single geometry type,
+     * i.e., the grid contains only simplices or only cubes, as announced by
+     * Capabilities::hasSingleGeometryType.  `MultipleCodimMultipleGeomTypeMapper`
+     * then looks up its offsets by codimension.
+     *
+     * Tests specialize this to false to force the generic lookup by geometry type.
+     */
+    template<class GV>
+    struct MCMGSingleTypePerCodim
+    {
+      static const unsigned int topologyId = Capabilities::hasSingleGeometryType<typename GV::Grid>::topologyId;
+      static const bool v = Capabilities::hasSingleGeometryType<typename GV::Grid>::v
+                            && (((topologyId | 1u) == 1u) || ((topologyId | 1u) == (1u << GV::dimension) - 1u));
+    };
+
   } /* namespace Impl */
 
   /**
@@ -177,6 +198,11 @@ namespace Dune
    * The geometry types to be included in the mapper are selected using a
    * layout functional (\ref MCMGLayout) that is passed to the constructor.
    *
+   * If the grid contains only simplices or only cubes, as announced by
+   * Capabilities::hasSingleGeometryType, each codimension has a single geometry
+   * type. The offsets are then looked up by the codimension, which is known at
+   * compile time for index(), and no geometry types are evaluated at all.
+   *
    * \tparam GV     A Dune GridView type.
    * \tparam LayoutClass (deprecated) A helper class template with a method contains(), that
    *                returns true for all geometry types that are in the domain
@@ -202,6 +228,9 @@ namespace Dune
     /** \brief Number type used for indices */
     typedef typename GV::IndexSet::IndexType Index;
 
+    /** \brief Range of the indices of all subentities of an element, see indices() */
+    typedef IteratorRange<const Index*> IndexRange;
+
     /** @brief Construct mapper from grid and one of its index sets.
      *
      * \param gridView_ A Dune GridView object.
@@ -243,9 +272,9 @@ namespace Dune
     template<class EntityType>
     Index index (const EntityType& e) const
     {
-      const GeometryType gt = e.type();
-      assert(offset(gt) != invalidOffset);
-      return is.index(e) + offset(gt);
+      const Index offset = singleTypePerCodim ? codimOffsets[EntityType::codimension] : this->offset(e.type());
+      assert(offset != invalidOffset);
+      return is.index(e) + offset;
     }
 
     /** @brief Map subentity of codim 0 entity to array index.
@@ -257,13 +286,41 @@ namespace Dune
      */
     Index subIndex (const typename GV::template Codim<0>::Entity& e, int i, unsigned int codim) const
     {
-      const GeometryType eType = e.type();
-      GeometryType gt = eType.isNone() ?
-        GeometryType( GeometryType::none, GV::dimension - codim ) :
-        ReferenceElements<double,GV::dimension>::general(eType).type(i,codim) ;
-      //GeometryType gt=ReferenceElements<double,GV::dimension>::general(e.type()).type(i,codim);
-      assert(offset(gt) != invalidOffset);
-      return is.subIndex(e, i, codim) + offset(gt);
+      const Index offset = singleTypePerCodim ? codimOffsets[codim] : subEntityOffset(e, i, codim);
+      assert(offset != invalidOffset);
+      return is.subIndex(e, i, codim) + offset;
+    }
+
+    /** @brief Return the indices of all subentities of an element that are in the entity set
+
+       The indices are ordered by codimension and, within a codimension, by the number
+       of the subentity, i.e. in the order of subIndex(e, i, codim) for codim = 0 ... dim
+       and i = 0 ... e.subEntities(codim)-1, skipping the subentities that are not in the set.
+
+       The indices are taken from tables that are filled by update() and only
+       available after cacheIndices() has been called.
+
+       \param e Reference to codim 0 entity.
+       \return A range of indices, valid until the next call of update().
+     */
+    IndexRange indices (const typename GV::template Codim<0>::Entity& e) const
+    {
+      assert(cacheIndices_);
+      const std::size_t row = is.index(e) + elementOffsets_[LocalGeometryTypeIndex::index(e.type())];
+      return IndexRange(cachedIndices_.data() + rowOffsets_[row], cachedIndices_.data() + rowOffsets_[row+1]);
+    }
+
+    /** @brief Store the indices of the subentities of all elements, for indices()
+
+       The tables are kept up to date by update(). They hold one index per subentity of
+       each element that is in the entity set, stored contiguously for each element.
+
+       \param enable Whether to build the tables; false releases them.
+     */
+    void cacheIndices (bool enable = true)
+    {
+      cacheIndices_ = enable;
+      update();
     }
 
     /** @brief Return total number of entities in the entity set managed by the mapper.
@@ -288,12 +345,13 @@ namespace Dune
     template<class EntityType>
     bool contains (const EntityType& e, Index& result) const
     {
-      if(!is.contains(e) || offset(e.type()) == invalidOffset)
+      const Index offset = singleTypePerCodim ? codimOffsets[EntityType::codimension] : this->offset(e.type());
+      if(!is.contains(e) || offset == invalidOffset)
       {
         result = 0;
         return false;
       }
-      result = index(e);
+      result = is.index(e) + offset;
       return true;
     }
 
@@ -307,14 +365,10 @@ namespace Dune
      */
     bool contains (const typename GV::template Codim<0>::Entity& e, int i, int cc, Index& result) const
     {
-      const GeometryType eType = e.type();
-      const GeometryType gt = eType.isNone() ?
-        GeometryType( GeometryType::none, GV::dimension - cc ) :
-        ReferenceElements<double,GV::dimension>::general(eType).type(i,cc) ;
-      //GeometryType gt=ReferenceElements<double,GV::dimension>::general(e.type()).type(i,cc);
-      if (offset(gt) == invalidOffset)
+      const Index offset = singleTypePerCodim ? codimOffsets[cc] : subEntityOffset(e, i, cc);
+      if (offset == invalidOffset)
         return false;
-      result = is.subIndex(e, i, cc) + offset(gt);
+      result = is.subIndex(e, i, cc) + offset;
       return true;
     }
 
@@ -326,6 +380,8 @@ namespace Dune
 
       for (unsigned int codim = 0; codim <= GV::dimension; ++codim)
       {
+        codimOffsets[codim] = invalidOffset;
+
         // walk over all geometry types in the codimension
         for (const GeometryType& gt : is.types(codim)) {
           Index offset;
@@ -340,18 +396,76 @@ namespace Dune
           }
 
           offsets[GlobalGeometryTypeIndex::index(gt)] = offset;
+          codimOffsets[codim] = offset;
         }
       }
+
+      updateIndexCache();
     }
 
     const MCMGLayout &layout () const { return layout_; }
 
   private:
+    // whether each codimension of the grid contains a single geometry type, see update()
+    static const bool singleTypePerCodim = Impl::MCMGSingleTypePerCodim<GV>::v;
+
     Index offset(GeometryType gt) const
       { return offsets[GlobalGeometryTypeIndex::index(gt)]; }
 
+    Index subEntityOffset(const typename GV::template Codim<0>::Entity& e, int i, unsigned int codim) const
+    {
+      const GeometryType eType = e.type();
+      const GeometryType gt = eType.isNone() ?
+        GeometryType( GeometryType::none, GV::dimension - codim ) :
+        ReferenceElements<double,GV::dimension>::general(eType).type(i,codim) ;
+      return offset(gt);
+    }
+
     static const Index invalidOffset = std::numeric_limits<Index>::max();
 
+    // Fill the tables returned by indices(), in compressed row storage with one row per element
+    void updateIndexCache ()
+    {
+      rowOffsets_.clear();
+      cachedIndices_.clear();
+      if (!cacheIndices_)
+      {
+        rowOffsets_.shrink_to_fit();
+        cachedIndices_.shrink_to_fit();
+        return;
+      }
+
+      // the rows of the elements are numbered like the elements in a mapper for codim 0
+      std::size_t rows = 0;
+      for (const GeometryType& gt : is.types(0)) {
+        elementOffsets_[LocalGeometryTypeIndex::index(gt)] = rows;
+        rows += is.size(gt);
+      }
+
+      // count the subentities in the entity set, then fill the rows
+      rowOffsets_.assign(rows+1, 0);
+      Index index;
+      for (const auto& e : elements(gridView))
+      {
+        std::size_t& count = rowOffsets_[is.index(e) + elementOffsets_[LocalGeometryTypeIndex::index(e.type())] + 1];
+        for (unsigned int codim = 0; codim <= GV::dimension; ++codim)
+          for (unsigned int i = 0; i < e.subEntities(codim); ++i)
+            count += contains(e, i, codim, index);
+      }
+      for (std::size_t row = 0; row < rows; ++row)
+        rowOffsets_[row+1] += rowOffsets_[row];
+
+      cachedIndices_.resize(rowOffsets_[rows]);
+      for (const auto& e : elements(gridView))
+      {
+        Index* row = cachedIndices_.data() + rowOffsets_[is.index(e) + elementOffsets_[LocalGeometryTypeIndex::index(e.type())]];
+        for (unsigned int codim = 0; codim <= GV::dimension; ++codim)
+          for (unsigned int i = 0; i < e.subEntities(codim); ++i)
+            if (contains(e, i, codim, index))
+              *row++ = index;
+      }
+    }
+
     // number of data elements required
     unsigned int n;
     // GridView is needed to keep the IndexSet valid
@@ -359,7 +473,14 @@ namespace Dune
     const typename GV::IndexSet& is;
     // provide an array for the offsets
     std::array<Index, GlobalGeometryTypeIndex::size(GV::dimension)> offsets;
+    // the offsets by codimension, only used if singleTypePerCodim is true
+    std::array<Index, GV::dimension+1> codimOffsets;
     const MCMGLayout layout_;     // get layout object
+    // tables for indices(), built only on request
+    bool cacheIndices_ = false;
+    std::array<std::size_t, LocalGeometryTypeIndex::size(GV::dimension)> elementOffsets_;
+    std::vector<std::size_t> rowOffsets_;
+    std::vector<Index> cachedIndices_;
 
   protected:
     /**
@@ -0,0 +1,199 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_COMMON_PARTITIONORDEREDMAPPER_HH
+#define DUNE_GRID_COMMON_PARTITIONORDEREDMAPPER_HH
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mapper.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+/**
+ * @file
+ * @brief  Mapper that numbers the entities of each partition type consecutively
+ */
+
+namespace Dune
+{
+  /**
+   * @addtogroup Mapper
+   *
+   * @{
+   */
+
+  /** @brief Multiple codim and multiple geometry type mapper, ordered by partition type
+   *
+   * This mapper maps the same entities as a MultipleCodimMultipleGeomTypeMapper with
+   * the same layout, but the indices are ordered by the PartitionType of the entities:
+   * first all interior entities, then the border, overlap, front and ghost entities.
+   * Within a partition type, the order of the MultipleCodimMultipleGeomTypeMapper is kept.
+   *
+   * Parallel solvers can thus work on the contiguous block of interior entities, given by
+   * begin(InteriorEntity) and end(InteriorEntity), while the data of the other partitions
+   * is being communicated.
+   *
+   * \tparam GV A Dune GridView type.
+   */
+  template <typename GV>
+  class PartitionOrderedMapper :
+    public Mapper<typename GV::Grid,PartitionOrderedMapper<GV>, typename GV::IndexSet::IndexType >
+  {
+    typedef MultipleCodimMultipleGeomTypeMapper<GV> BaseMapper;
+
+    enum { dim = GV::dimension };
+
+    // number of partition types
+    enum { nPartitions = GhostEntity+1 };
+
+  public:
+
+    /** \brief Number type used for indices */
+    typedef typename GV::IndexSet::IndexType Index;
+
+    /**
+     * \brief construct mapper from grid view and layout description
+     *
+     * \param gridView grid view whose entities should be included in the mapper
+     * \param layout   functional describing which entities are included in the mapper,
+     *                 see \ref MCMGLayout
+     */
+    PartitionOrderedMapper (const GV& gridView, const MCMGLayout& layout)
+      : gridView_(gridView)
+      , mapper_(gridView, layout)
+    {
+      updateOrder();
+    }
+
+    /** @brief Map entity to array index.
+
+       \param e Reference to an entity.
+       \return An index in the range 0 ... Max number of entities in set - 1.
+     */
+    template<class EntityType>
+    Index index (const EntityType& e) const
+    {
+      return order_[mapper_.index(e)];
+    }
+
+    /** @brief Map subentity of codim 0 entity to array index.
+
+       \param e Reference to codim 0 entity.
+       \param i Number of subentity of e
+       \param codim Codimension of the subentity
+       \return An index in the range 0 ... Max number of entities in set - 1.
+     */
+    Index subIndex (const typename GV::template Codim<0>::Entity& e, int i, unsigned int codim) const
+    {
+      return order_[mapper_.subIndex(e, i, codim)];
+    }
+
+    /** @brief Return total number of entities in the entity set managed by the mapper.
+     */
+    int size () const
+    {
+      return mapper_.size();
+    }
+
+    /** @brief First index of the entities of a given partition type */
+    Index begin (PartitionType partitionType) const
+    {
+      return offsets_[partitionType];
+    }
+
+    /** @brief One past the last index of the entities of a given partition type */
+    Index end (PartitionType partitionType) const
+    {
+      return offsets_[partitionType+1];
+    }
+
+    /** @brief Returns true if the entity is contained in the index set
+
+       \param e Reference to entity
+       \param result integer reference where corresponding index is  stored if true
+       \return true if entity is in entity set of the mapper
+     */
+    template<class EntityType>
+    bool contains (const EntityType& e, Index& result) const
+    {
+      if (!mapper_.contains(e, result))
+        return false;
+      result = order_[result];
+      return true;
+    }
+
+    /** @brief Returns true if the entity is contained in the index set
+
+       \param e Reference to codim 0 entity
+       \param i subentity number
+       \param cc subentity codim
+       \param result integer reference where corresponding index is  stored if true
+       \return true if entity is in entity set of the mapper
+     */
+    bool contains (const typename GV::template Codim<0>::Entity& e, int i, int cc, Index& result) const
+    {
+      if (!mapper_.contains(e, i, cc, result))
+        return false;
+      result = order_[result];
+      return true;
+    }
+
+    /** @brief Recalculates map after mesh adaptation
+     */
+    void update ()
+    {
+      mapper_.update();
+      updateOrder();
+    }
+
+  private:
+    // sort the indices of the MultipleCodimMultipleGeomTypeMapper by partition type
+    void updateOrder ()
+    {
+      // partition type of each entity, found in a single traversal of the elements
+      std::vector<unsigned char> partition(mapper_.size(), nPartitions);
+      for (const auto& element : elements(gridView_))
+        Hybrid::forEach(std::make_index_sequence<dim+1>{}, [&](auto codim) {
+            for (unsigned int i = 0; i < element.subEntities(codim); ++i)
+            {
+              Index index;
+              if (mapper_.contains(element, i, codim, index))
+                partition[index] = element.template subEntity<codim>(i).partitionType();
+            }
+          });
+
+      offsets_.fill(0);
+      for (unsigned char p : partition)
+      {
+        assert(p < nPartitions);
+        ++offsets_[p+1];
+      }
+      for (int p = 0; p < nPartitions; ++p)
+        offsets_[p+1] += offsets_[p];
+
+      std::array<Index, nPartitions> next;
+      std::copy(offsets_.begin(), offsets_.end()-1, next.begin());
+      order_.resize(partition.size());
+      for (std::size_t index = 0; index < partition.size(); ++index)
+        order_[index] = next[partition[index]]++;
+    }
+
+    // GridView is needed to keep the IndexSet valid
+    const GV gridView_;
+    BaseMapper mapper_;
+    // index of the entities, by the index of mapper_
+    std::vector<Index> order_;
+    // first index of each partition type
+    std::array<Index, nPartitions+1> offsets_;
+  };
+
+  /** @} */
+}
+#endif
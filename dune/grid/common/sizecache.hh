@@ -3,9 +3,9 @@
 #ifndef DUNE_SIZECACHE_HH
 #define DUNE_SIZECACHE_HH
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
-#include <set>
 #include <utility>
 
 #include <dune/common/exceptions.hh>
@@ -144,11 +144,24 @@ namespace Dune {
 
     /** \brief reset all cached sizes */
     void reset()
+    {
+      reset( 0 );
+    }
+
+    /** \brief reset the cached leaf sizes and the level sizes from a given level on
+     *
+     *  After adaptation, only the levels that gained or lost entities have to
+     *  be counted again. The sizes of the coarser levels are kept. All sizes
+     *  are counted lazily, for one codimension at a time on the first query.
+     *
+     *  \param minLevel coarsest level that has changed
+     */
+    void reset( int minLevel )
     {
       for(int codim=0; codim<nCodim; ++codim)
       {
         leafSizes_[ codim ] = -1;
-        leafTypeSizes_[ codim ].resize( sizeCodim( codim ), -1 );
+        leafTypeSizes_[ codim ].assign( sizeCodim( codim ), -1 );
       }
 
       const int numMxl = grid_.maxLevel()+1;
@@ -157,10 +170,10 @@ namespace Dune {
         std::vector<int> & vec = levelSizes_[codim];
         vec.resize(numMxl);
         levelTypeSizes_[codim].resize( numMxl );
-        for(int level = 0; level<numMxl; ++level)
+        for(int level = std::max( minLevel, 0 ); level<numMxl; ++level)
         {
           vec[level] = -1;
-          levelTypeSizes_[codim][level].resize( sizeCodim( codim ), -1 );
+          levelTypeSizes_[codim][level].assign( sizeCodim( codim ), -1 );
         }
       }
     }
@@ -300,7 +313,7 @@ namespace Dune {
       typedef ReferenceElement< ctype, dim > ReferenceElementType;
       typedef ReferenceElements< ctype, dim > ReferenceElementContainerType;
 
-      typedef std::set< IdType > CodimIdSetType ;
+      typedef std::vector< IdType > CodimIdSetType ;
 
       typedef typename IteratorType :: Entity ElementType ;
 
@@ -329,8 +342,8 @@ namespace Dune {
           const GeometryType geomType = refElem.type( i, codim );
           // get id of sub entity
           const IdType id = idSet.subId( element, i, codim );
-          // insert id into set
-          typeCount[ gtIndex( geomType ) ].insert( id );
+          // collect ids, the duplicates are removed below
+          typeCount[ gtIndex( geomType ) ].push_back( id );
         }
       }
 
@@ -338,7 +351,8 @@ namespace Dune {
       int overall = 0;
       for(size_t i=0; i<types; ++i)
       {
-        typeSizes[ i ] = typeCount[ i ].size();
+        std::sort( typeCount[ i ].begin(), typeCount[ i ].end() );
+        typeSizes[ i ] = std::unique( typeCount[ i ].begin(), typeCount[ i ].end() ) - typeCount[ i ].begin();
         overall += typeSizes[ i ];
       }
 
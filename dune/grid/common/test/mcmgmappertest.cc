@@ -7,12 +7,17 @@
 
 #include <config.h>
 
+#include <array>
+#include <cstdlib>
 #include <iostream>
 #include <set>
+#include <string>
 
 #include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
 #include <dune/grid/common/mcmgmapper.hh>
 #include <dune/grid/uggrid.hh>
+#include <dune/grid/yaspgrid.hh>
 #include "../../../../doc/grids/gridfactory/hybridtestgrids.hh"
 
 using namespace Dune;
@@ -152,6 +157,136 @@ void checkMixedDataMapper(const Mapper& mapper, const GridView& gridView)
   }
 }
 
+/*!
+ * \brief Check that the cached indices of the subentities of each element
+ * agree with subIndex, and compare the time of both.
+ */
+template <class Mapper, class GridView>
+void checkIndexCache(Mapper& mapper, const GridView& gridView)
+{
+  const size_t dim = GridView::dimension;
+
+  mapper.cacheIndices();
+
+  Timer watch;
+  size_t sum = 0;
+  for (const auto& element : elements(gridView))
+    for (size_t codim = 0; codim <= dim; ++codim)
+      for (size_t i = 0; i < element.subEntities(codim); ++i)
+      {
+        typename Mapper::Index index;
+        if (mapper.contains(element, i, codim, index))
+          sum += index;
+      }
+  const double subIndexTime = watch.elapsed();
+
+  watch.reset();
+  size_t cachedSum = 0;
+  for (const auto& element : elements(gridView))
+    for (const auto index : mapper.indices(element))
+      cachedSum += index;
+  const double cachedTime = watch.elapsed();
+
+  for (const auto& element : elements(gridView))
+  {
+    auto index = mapper.indices(element).begin();
+    for (size_t codim = 0; codim <= dim; ++codim)
+      for (size_t i = 0; i < element.subEntities(codim); ++i)
+      {
+        typename Mapper::Index expected;
+        if (mapper.contains(element, i, codim, expected) && *index++ != expected)
+          DUNE_THROW(GridError, "Cached index differs from subIndex!");
+      }
+    if (index != mapper.indices(element).end())
+      DUNE_THROW(GridError, "Cached indices contain too many subentities!");
+  }
+  if (sum != cachedSum)
+    DUNE_THROW(GridError, "Cached indices differ from subIndex!");
+
+  std::cout << "subIndex: " << subIndexTime << " s, cached indices: " << cachedTime << " s" << std::endl;
+}
+
+/*!
+ * \brief The same grid view, but the mapper has to look up offsets by geometry type
+ */
+template <class GridView>
+struct GenericLookupGridView : public GridView
+{
+  GenericLookupGridView(const GridView& gridView) : GridView(gridView) {}
+};
+
+namespace Dune {
+  namespace Impl {
+    template <class GridView>
+    struct MCMGSingleTypePerCodim<GenericLookupGridView<GridView> >
+    {
+      static const bool v = false;
+    };
+  }
+}
+
+/*!
+ * \brief Compare the lookup of offsets by codimension with the generic lookup by geometry type.
+ *
+ * Both mappers work on the same grid view, which has a single geometry type
+ * per codimension. The mapper indices have to agree; the time of subIndex
+ * is reported for the index set and for both mappers.
+ */
+template <class GridView>
+void benchmarkSubIndex(const GridView& gridView, const std::string& name)
+{
+  static_assert(Impl::MCMGSingleTypePerCodim<GridView>::v, "The grid view has to have a single geometry type per codimension");
+
+  const size_t dim = GridView::dimension;
+  const auto allLayout = [](GeometryType, int) { return true; };
+  MultipleCodimMultipleGeomTypeMapper<GridView> mapper(gridView, allLayout);
+  const GenericLookupGridView<GridView> genericGridView(gridView);
+  MultipleCodimMultipleGeomTypeMapper<GenericLookupGridView<GridView> > genericMapper(genericGridView, allLayout);
+  const auto& indexSet = gridView.indexSet();
+
+  if (mapper.size() != genericMapper.size())
+    DUNE_THROW(GridError, "Mapper sizes differ between the lookup by codimension and by geometry type!");
+  for (const auto& element : elements(gridView))
+  {
+    if (mapper.index(element) != genericMapper.index(element))
+      DUNE_THROW(GridError, "Element indices differ between the lookup by codimension and by geometry type!");
+    for (size_t codim = 0; codim <= dim; ++codim)
+      for (size_t i = 0; i < element.subEntities(codim); ++i)
+        if (mapper.subIndex(element, i, codim) != genericMapper.subIndex(element, i, codim))
+          DUNE_THROW(GridError, "Subentity indices differ between the lookup by codimension and by geometry type!");
+  }
+
+  Timer watch;
+  size_t indexSetSum = 0;
+  for (const auto& element : elements(gridView))
+    for (size_t codim = 0; codim <= dim; ++codim)
+      for (size_t i = 0; i < element.subEntities(codim); ++i)
+        indexSetSum += indexSet.subIndex(element, i, codim);
+  const double indexSetTime = watch.elapsed();
+
+  watch.reset();
+  size_t mapperSum = 0;
+  for (const auto& element : elements(gridView))
+    for (size_t codim = 0; codim <= dim; ++codim)
+      for (size_t i = 0; i < element.subEntities(codim); ++i)
+        mapperSum += mapper.subIndex(element, i, codim);
+  const double mapperTime = watch.elapsed();
+
+  watch.reset();
+  size_t genericSum = 0;
+  for (const auto& element : elements(gridView))
+    for (size_t codim = 0; codim <= dim; ++codim)
+      for (size_t i = 0; i < element.subEntities(codim); ++i)
+        genericSum += genericMapper.subIndex(element, i, codim);
+  const double genericTime = watch.elapsed();
+
+  if (mapperSum < indexSetSum || mapperSum != genericSum)
+    DUNE_THROW(GridError, "Mapper indices do not match the index set!");
+
+  std::cout << name << ": index set " << indexSetTime << " s, mapper by codimension " << mapperTime
+            << " s, mapper by geometry type " << genericTime << " s" << std::endl;
+}
+
 /*!
  * \brief Run checks for a given grid.
  *
@@ -266,6 +401,7 @@ void checkGrid(const Grid& grid)
     LeafMultipleCodimMultipleGeomTypeMapper<Grid>
     leafMCMGMapper(grid, elementEdgeLayout);
     checkMixedDataMapper(leafMCMGMapper, grid.leafGridView());
+    checkIndexCache(leafMCMGMapper, grid.leafGridView());
   }
 
   // check levelMCMGMapper
@@ -326,6 +462,19 @@ try
     checkGrid(*grid);
   }
 
+  // Compare the lookup of the offsets by codimension with the generic
+  // lookup by geometry type on the same grid view
+  {
+    const int n = (argc > 1) ? std::atoi(argv[1]) : 8;
+    const FieldVector<double,3> upper(1);
+    const std::array<int,3> cells = {{n, n, n}};
+
+    YaspGrid<3> yaspGrid(upper, cells);
+    checkVertexDataMapper(MultipleCodimMultipleGeomTypeMapper<YaspGrid<3>::LeafGridView>(yaspGrid.leafGridView(), mcmgVertexLayout()),
+                          yaspGrid.leafGridView());
+    benchmarkSubIndex(yaspGrid.leafGridView(), "YaspGrid<3>");
+  }
+
   return EXIT_SUCCESS;
 
 }
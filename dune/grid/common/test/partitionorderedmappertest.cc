@@ -0,0 +1,109 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the PartitionOrderedMapper
+
+    The mapper has to number the entities consecutively, and the entities of
+    each partition type have to lie in the range of indices of the partition.
+ */
+
+#include <config.h>
+
+#include <array>
+#include <bitset>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/partitionorderedmapper.hh>
+
+using namespace Dune;
+
+template <class GridView>
+void checkMapper(const GridView& gridView, const MCMGLayout& layout)
+{
+  const int dim = GridView::dimension;
+  PartitionOrderedMapper<GridView> mapper(gridView, layout);
+  MultipleCodimMultipleGeomTypeMapper<GridView> referenceMapper(gridView, layout);
+
+  if (mapper.size() != referenceMapper.size())
+    DUNE_THROW(GridError, "PartitionOrderedMapper has size " << mapper.size()
+               << " instead of " << referenceMapper.size());
+  if (mapper.begin(InteriorEntity) != 0 || mapper.end(GhostEntity) != mapper.size())
+    DUNE_THROW(GridError, "The partitions do not cover the indices of the mapper");
+
+  // every index is used once, within the range of the partition type of its entity
+  std::vector<bool> used(mapper.size(), false);
+  for (const auto& element : elements(gridView))
+  {
+    const int codims[] = {0, 1, dim};
+    for (int codim : codims)
+      for (unsigned int i = 0; i < element.subEntities(codim); ++i)
+      {
+        typename PartitionOrderedMapper<GridView>::Index index, referenceIndex;
+        const bool contained = mapper.contains(element, i, codim, index);
+        if (contained != referenceMapper.contains(element, i, codim, referenceIndex))
+          DUNE_THROW(GridError, "PartitionOrderedMapper contains different entities");
+        if (!contained)
+          continue;
+        if (index != mapper.subIndex(element, i, codim))
+          DUNE_THROW(GridError, "contains() and subIndex() differ");
+
+        PartitionType partitionType = element.partitionType();
+        if (codim == 1)
+          partitionType = element.template subEntity<1>(i).partitionType();
+        else if (codim == dim)
+          partitionType = element.template subEntity<dim>(i).partitionType();
+        if (index < mapper.begin(partitionType) || index >= mapper.end(partitionType))
+          DUNE_THROW(GridError, "Index " << index << " of a " << partitionType << " entity is outside of ["
+                     << mapper.begin(partitionType) << ", " << mapper.end(partitionType) << ")");
+
+        used[index] = true;
+      }
+    if (mapper.index(element) != mapper.subIndex(element, 0, 0))
+      DUNE_THROW(GridError, "index() and subIndex() differ for an element");
+  }
+
+  for (int k = 0; k < mapper.size(); ++k)
+    if (!used[k])
+      DUNE_THROW(GridError, "Index " << k << " is not used");
+
+  std::cout << "Rank " << gridView.comm().rank() << ":";
+  for (int p = InteriorEntity; p <= GhostEntity; ++p)
+    std::cout << " " << PartitionType(p) << " [" << mapper.begin(PartitionType(p)) << ", " << mapper.end(PartitionType(p)) << ")";
+  std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+try
+{
+  MPIHelper& mpiHelper = MPIHelper::instance(argc, argv);
+
+  const int dim = 2;
+  const FieldVector<double,dim> upper(1.0);
+  const std::array<int,dim> cells = {{8, 8}};
+
+  for (int overlap = 0; overlap <= 1; ++overlap)
+  {
+    YaspGrid<dim> grid(upper, cells, std::bitset<dim>(0ULL), overlap, mpiHelper.getCollectiveCommunication());
+    const auto gridView = grid.leafGridView();
+
+    checkMapper(gridView, mcmgElementLayout());
+    checkMapper(gridView, mcmgVertexLayout());
+    checkMapper(gridView, [](GeometryType gt, int) { return true; });
+  }
+
+  return 0;
+}
+catch (Exception &e) {
+  std::cerr << e << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
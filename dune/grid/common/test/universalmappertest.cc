@@ -0,0 +1,127 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the UniversalMapper and the HashedUniversalMapper
+
+    Both mappers have to assign the same indices, if the entities are queried
+    in the same order.  The time for looking up all entities is reported for
+    the UniversalMapper, the HashedUniversalMapper and the frozen
+    HashedUniversalMapper.
+ */
+
+#include <config.h>
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/universalmapper.hh>
+
+using namespace Dune;
+
+// query all subentities of codimension codim in the order of insert()
+template <class Mapper, class GridView>
+double queryAll(const Mapper& mapper, const GridView& gridView, int codim, std::vector<typename Mapper::Index>& indices)
+{
+  Timer watch;
+  indices.clear();
+  for (const auto& element : elements(gridView))
+  {
+    if (codim == 0)
+      indices.push_back(mapper.index(element));
+    else
+      for (unsigned int i = 0; i < element.subEntities(codim); ++i)
+        indices.push_back(mapper.subIndex(element, i, codim));
+  }
+  return watch.elapsed();
+}
+
+template <class GridView>
+void checkMappers(const GridView& gridView)
+{
+  typedef typename GridView::Grid Grid;
+  typedef typename Grid::LocalIdSet IdSet;
+  const Grid& grid = gridView.grid();
+
+  for (int codim = 0; codim <= Grid::dimension; ++codim)
+  {
+    UniversalMapper<Grid, IdSet> mapper(grid, grid.localIdSet());
+    HashedUniversalMapper<Grid, IdSet> hashedMapper(grid, grid.localIdSet());
+    HashedUniversalMapper<Grid, IdSet> bulkMapper(grid, grid.localIdSet());
+    bulkMapper.insert(gridView, codim);
+
+    std::vector<int> indices, hashedIndices, bulkIndices;
+    queryAll(mapper, gridView, codim, indices);
+    queryAll(hashedMapper, gridView, codim, hashedIndices);
+    queryAll(bulkMapper, gridView, codim, bulkIndices);
+    if (hashedIndices != indices || bulkIndices != indices)
+      DUNE_THROW(GridError, "HashedUniversalMapper and UniversalMapper differ for codim " << codim);
+    if (mapper.size() != gridView.size(codim) || hashedMapper.size() != mapper.size() || bulkMapper.size() != mapper.size())
+      DUNE_THROW(GridError, "Wrong size of the mappers for codim " << codim);
+
+    // repeated queries must not create new indices
+    const double time = queryAll(mapper, gridView, codim, indices);
+    const double hashedTime = queryAll(hashedMapper, gridView, codim, hashedIndices);
+    if (hashedIndices != indices || hashedMapper.size() != mapper.size())
+      DUNE_THROW(GridError, "HashedUniversalMapper created new indices for known entities");
+
+    hashedMapper.freeze();
+    const double frozenTime = queryAll(hashedMapper, gridView, codim, hashedIndices);
+    if (hashedIndices != indices || hashedMapper.size() != mapper.size())
+      DUNE_THROW(GridError, "Frozen HashedUniversalMapper differs for codim " << codim);
+
+    // only entities of the mapped codimension are known
+    const auto& element = *gridView.template begin<0>();
+    int index;
+    if (codim != 0 && (hashedMapper.contains(element, index) || bulkMapper.contains(element, index)))
+      DUNE_THROW(GridError, "HashedUniversalMapper contains an unknown element");
+    if (!hashedMapper.contains(element, 0, codim, index) || index != indices[0])
+      DUNE_THROW(GridError, "Frozen HashedUniversalMapper does not contain a known entity");
+
+    bool thrown = false;
+    try {
+      hashedMapper.index(element);
+    }
+    catch (InvalidStateException&) {
+      thrown = true;
+    }
+    if (thrown != (codim != 0))
+      DUNE_THROW(GridError, "Frozen HashedUniversalMapper did not reject an unknown entity");
+
+    hashedMapper.unfreeze();
+    if (codim != 0 && hashedMapper.index(element) != mapper.size())
+      DUNE_THROW(GridError, "Unfrozen HashedUniversalMapper did not register a new entity");
+
+    std::cout << "codim " << codim << ": " << mapper.size() << " entities, lookup in " << time << " s (std::map), "
+              << hashedTime << " s (hashed), " << frozenTime << " s (frozen)" << std::endl;
+  }
+}
+
+int main (int argc, char** argv)
+try
+{
+  MPIHelper::instance(argc, argv);
+  const int cells = (argc > 1) ? std::atoi(argv[1]) : 64;
+
+  YaspGrid<2> grid(FieldVector<double,2>(1.0), std::array<int,2>{ {cells, cells} });
+  checkMappers(grid.leafGridView());
+
+  return 0;
+}
+catch (Exception& e)
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch (...)
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
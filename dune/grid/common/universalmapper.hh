@@ -3,8 +3,17 @@
 #ifndef DUNE_GRID_COMMON_UNIVERSALMAPPER_HH
 #define DUNE_GRID_COMMON_UNIVERSALMAPPER_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/hash.hh>
+
 #include "mapper.hh"
 
 /**
@@ -166,6 +175,279 @@ namespace Dune
   };
 
 
+  /** @brief Implements a mapper for an arbitrary subset of entities using a hash table
+
+      This mapper behaves like UniversalMapper, but stores the ids in an open
+      addressing hash table.  Thus, each access has constant complexity on
+      average.  The id type has to be hashable by Dune::hash.
+
+      Besides registering entities on their first query, the table can be
+      reserved in advance and all entities of a codimension in a grid view can
+      be registered in one pass by insert().
+
+      For phases in which no new entities are queried, the mapper can be
+      frozen.  A frozen mapper stores the ids in a sorted array, which takes
+      less memory and is searched by bisection.  Querying an unknown entity
+      from a frozen mapper throws an InvalidStateException.
+
+   * \tparam G   A Dune grid type.
+   * \tparam IDS An Id set type for the given grid.
+   * \tparam IndexType Number type used for the indices
+   */
+  template <typename G, typename IDS, typename IndexType=int>
+  class HashedUniversalMapper :
+    public Mapper<G,HashedUniversalMapper<G,IDS,IndexType>,IndexType>
+  {
+    typedef typename IDS::IdType IdType;
+
+    // marker for an empty slot in the hash table
+    static const std::size_t empty = std::size_t(-1);
+
+  public:
+
+    /** \brief Number type used for indices */
+    typedef IndexType Index;
+
+    /** @brief Construct mapper from grid and one of its id sets
+
+       \param grid A Dune grid object.
+       \param idset An IndexSet object of the grid.
+
+     */
+    HashedUniversalMapper (const G& grid, const IDS& idset)
+      : g(grid), ids(idset), logCapacity_(0), frozen_(false)
+    {}
+
+    /** @brief Map entity to array index.
+
+       If an entity is queried with map, the known index is returned or a new index is created.
+       This fails only if the mapper is frozen.
+
+            \param e Reference to codim cc entity, where cc is the template parameter of the function.
+            \return An index in the range 0 ... Max number of entities in set - 1.
+     */
+    template<class EntityType>
+    Index index (const EntityType& e) const
+    {
+      return lookup(ids.id(e));
+    }
+
+    /** @brief Map subentity of codim 0 entity to array index.
+
+       If an entity is queried with map, the known index is returned or a new index is created.
+       This fails only if the mapper is frozen.
+
+       \param e Reference to codim 0 entity.
+       \param i Number of codim cc subentity of e, where cc is the template parameter of the function.
+       \param cc codim of the subentity
+       \return An index in the range 0 ... Max number of entities in set - 1.
+     */
+    Index subIndex (const typename G::Traits::template Codim<0>::Entity& e, int i, int cc) const
+    {
+      return lookup(ids.subId(e,i,cc));
+    }
+
+    /** @brief Return total number of entities in the entity set managed by the mapper.
+
+       \return Size of the entity set.
+     */
+    int size () const
+    {
+      return frozen_ ? sorted_.size() : idOfIndex_.size();
+    }
+
+    /** @brief Returns true if the entity is contained in the index set
+
+       The method contains only return true, if the entites was queried via map already.
+
+       \param e Reference to entity
+       \param result integer reference where corresponding index is  stored if true
+       \return true if entity is in entity set of the mapper
+     */
+    template<class EntityType>
+    bool contains (const EntityType& e, Index& result) const
+    {
+      return find(ids.id(e), result);
+    }
+
+    /** @brief Returns true if the entity is contained in the index set
+
+       \param[in] e Reference to codim 0 entity
+       \param[in] i subentity number
+       \param[in] cc subentity codim
+       \param[out] result integer reference where corresponding index is stored if true
+       \return true if entity is in entity set of the mapper
+     */
+    bool contains (const typename G::Traits::template Codim<0>::Entity& e, int i, int cc, Index& result) const
+    {
+      return find(ids.subId(e,i,cc), result);
+    }
+
+    /** @brief Recalculates map after mesh adaptation
+     */
+    void update ()
+    {     // nothing to do here
+    }
+
+    // clear the mapper
+    void clear ()
+    {
+      idOfIndex_.clear();
+      table_.clear();
+      sorted_.clear();
+      logCapacity_ = 0;
+      frozen_ = false;
+    }
+
+    /** @brief Reserve memory, such that n entities can be registered without rehashing */
+    void reserve (std::size_t n)
+    {
+      idOfIndex_.reserve(n);
+      if (2*n > table_.size())
+        rehash(2*n);
+    }
+
+    /** @brief Register all entities of codimension codim in a grid view
+
+       The entities get their indices in the order of a traversal of the
+       elements and their subentities, as if they had been queried by
+       index() or subIndex() in this order.
+     */
+    template<class GridView>
+    void insert (const GridView& gridView, int codim)
+    {
+      reserve(size() + gridView.size(codim));
+      for (const auto& element : elements(gridView))
+      {
+        if (codim == 0)
+          lookup(ids.id(element));
+        else
+          for (unsigned int i = 0; i < element.subEntities(codim); ++i)
+            lookup(ids.subId(element, i, codim));
+      }
+    }
+
+    /** @brief Replace the hash table by a sorted array for read-only access */
+    void freeze ()
+    {
+      if (frozen_)
+        return;
+      sorted_.resize(idOfIndex_.size());
+      for (std::size_t i = 0; i < idOfIndex_.size(); ++i)
+        sorted_[i] = std::make_pair(idOfIndex_[i], Index(i));
+      std::sort(sorted_.begin(), sorted_.end());
+      std::vector<IdType>().swap(idOfIndex_);
+      std::vector<std::size_t>().swap(table_);
+      logCapacity_ = 0;
+      frozen_ = true;
+    }
+
+    /** @brief Rebuild the hash table, such that new entities can be registered again */
+    void unfreeze ()
+    {
+      if (!frozen_)
+        return;
+      idOfIndex_.resize(sorted_.size());
+      for (const auto& entry : sorted_)
+        idOfIndex_[entry.second] = entry.first;
+      std::vector<std::pair<IdType,Index> >().swap(sorted_);
+      frozen_ = false;
+      rehash(2*idOfIndex_.size());
+    }
+
+    //! Whether the mapper is frozen
+    bool frozen () const
+    {
+      return frozen_;
+    }
+
+  private:
+    // slot of an id in a table of 2^logCapacity_ entries (Fibonacci hashing)
+    std::size_t slot (const IdType& id) const
+    {
+      const std::uint64_t h = hash<IdType>()(id);
+      return (h * std::uint64_t(11400714819323198485ull)) >> (64 - logCapacity_);
+    }
+
+    // rebuild the hash table with a capacity of at least the given size
+    void rehash (std::size_t capacity) const
+    {
+      logCapacity_ = 4;
+      while ((std::size_t(1) << logCapacity_) < capacity)
+        ++logCapacity_;
+      table_.assign(std::size_t(1) << logCapacity_, std::size_t(empty));
+
+      const std::size_t mask = table_.size() - 1;
+      for (std::size_t i = 0; i < idOfIndex_.size(); ++i)
+      {
+        std::size_t pos = slot(idOfIndex_[i]);
+        while (table_[pos] != empty)
+          pos = (pos + 1) & mask;
+        table_[pos] = i;
+      }
+    }
+
+    // look up an id, register it if it is not known yet
+    Index lookup (const IdType& id) const
+    {
+      if (frozen_)
+      {
+        Index result;
+        if (!find(id, result))
+          DUNE_THROW(InvalidStateException, "A frozen HashedUniversalMapper cannot register new entities");
+        return result;
+      }
+
+      // keep the load factor below one half
+      if (2*(idOfIndex_.size() + 1) > table_.size())
+        rehash(2*table_.size());
+
+      const std::size_t mask = table_.size() - 1;
+      std::size_t pos = slot(id);
+      for (; table_[pos] != empty; pos = (pos + 1) & mask)
+        if (idOfIndex_[table_[pos]] == id)
+          return table_[pos];
+
+      table_[pos] = idOfIndex_.size();
+      idOfIndex_.push_back(id);
+      return table_[pos];
+    }
+
+    // look up an id without registering it
+    bool find (const IdType& id, Index& result) const
+    {
+      if (frozen_)
+      {
+        const auto pos = std::lower_bound(sorted_.begin(), sorted_.end(), id,
+                                          [] (const std::pair<IdType,Index>& entry, const IdType& key) { return entry.first < key; });
+        if (pos == sorted_.end() || !(pos->first == id))
+          return false;
+        result = pos->second;
+        return true;
+      }
+
+      if (table_.empty())
+        return false;
+      const std::size_t mask = table_.size() - 1;
+      for (std::size_t pos = slot(id); table_[pos] != empty; pos = (pos + 1) & mask)
+        if (idOfIndex_[table_[pos]] == id)
+        {
+          result = table_[pos];
+          return true;
+        }
+      return false;
+    }
+
+    const G& g;
+    const IDS& ids;
+    mutable std::vector<IdType> idOfIndex_;      // id of each index
+    mutable std::vector<std::size_t> table_;     // hash table of indices into idOfIndex_
+    mutable int logCapacity_;
+    std::vector<std::pair<IdType,Index> > sorted_;   // sorted ids of a frozen mapper
+    bool frozen_;
+  };
+
+
 
 
   /** @brief Universal mapper based on global ids
@@ -18,7 +18,8 @@ namespace Dune
         active(false),
         empty(true),
         identifier(id),
-        linecount(0)
+        linecount(0),
+        blockpos_(0)
     {
       makeupcase( identifier );
       in.clear();
@@ -42,17 +43,24 @@ namespace Dune
     void BasicBlock :: getblock ( std :: istream &in )
     {
       linecount = 0;
+      std::string curLine;
       while( in.good() )
       {
-        std::string curLine;
         getline( in, curLine );
 
-        std::istringstream linestream( curLine );
-        std :: string id;
-        linestream >> id;
-
-        makeupcase( id );
-        if( id == identifier )
+        // compare the first word of the line with the identifier
+        std::size_t begin = 0;
+        while( (begin < curLine.size()) && std::isspace( (unsigned char)curLine[ begin ] ) )
+          ++begin;
+        std::size_t end = begin;
+        while( (end < curLine.size()) && !std::isspace( (unsigned char)curLine[ end ] ) )
+          ++end;
+        if( end - begin != identifier.size() )
+          continue;
+        std::size_t i = 0;
+        while( (i < identifier.size()) && (std::toupper( curLine[ begin+i ] ) == identifier[ i ]) )
+          ++i;
+        if( i == identifier.size() )
           break;
       }
       if( in.eof() )
@@ -61,7 +69,6 @@ namespace Dune
       active = true;
       while( in.good() )
       {
-        std::string curLine;
         getline( in, curLine );
 
         // strip comments
@@ -74,14 +81,15 @@ namespace Dune
         if( curLine.empty() )
           continue;
 
-        std :: istringstream linestream( curLine );
-        char test = 0;
-        linestream >> test;
-        if( test == '#' )
+        std::size_t first = 0;
+        while( (first < curLine.size()) && std::isspace( (unsigned char)curLine[ first ] ) )
+          ++first;
+        if( (first < curLine.size()) && (curLine[ first ] == '#') )
           return;
 
         ++linecount;
-        block_ << curLine << std :: endl;
+        block_ += curLine;
+        block_ += '\n';
       }
       DUNE_THROW( DGFException,
                   "Error reading from stream, expected \"#\" to end the block." );
@@ -91,7 +99,14 @@ namespace Dune
     // get next line and store in string stream
     bool BasicBlock :: getnextline ()
     {
-      getline( block_, oneline );
+      if( blockpos_ < block_.size() )
+      {
+        const std::size_t end = block_.find( '\n', blockpos_ );
+        oneline.assign( block_, blockpos_, end - blockpos_ );
+        blockpos_ = end + 1;
+      }
+      else
+        oneline.clear();
       line.clear();
       line.str( oneline );
       ++pos;
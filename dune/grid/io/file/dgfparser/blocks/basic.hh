@@ -5,9 +5,13 @@
 
 #include <cassert>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 #include <dune/common/stdstreams.hh>
 #include <dune/grid/io/file/dgfparser/entitykey.hh>
@@ -32,7 +36,8 @@ namespace Dune
       bool empty;                // block was found but was empty
       std::string identifier;    // identifier of this block
       int linecount;             // total number of lines in the block
-      std::stringstream block_;  // the block itself
+      std::string block_;        // the block itself, one line per '\n'
+      std::size_t blockpos_;     // beginning of the next line in block_
       std::string oneline;       // the active line in the block
 
       // get the block (if it exists)
@@ -49,8 +54,7 @@ namespace Dune
       void reset ()
       {
         pos = -1;
-        block_.clear();
-        block_.seekg( 0 );
+        blockpos_ = 0;
       }
 
       // get next line and store in string stream
@@ -60,13 +64,82 @@ namespace Dune
       template< class ENTRY >
       bool getnextentry( ENTRY &entry )
       {
-        line >> entry;
-        return static_cast< bool >( line );
+        typedef std::integral_constant< bool, std::is_floating_point< ENTRY >::value
+                                              || (std::is_integral< ENTRY >::value && (sizeof( ENTRY ) > 1)) > IsNumber;
+        return getnextentry( entry, IsNumber() );
       }
 
       bool gettokenparam ( std :: string token, std :: string &entry );
       bool findtoken( std :: string token );
 
+    private:
+      template< class ENTRY >
+      bool getnextentry( ENTRY &entry, std::false_type )
+      {
+        line >> entry;
+        return static_cast< bool >( line );
+      }
+
+      // numbers are parsed directly from the active line, which is much
+      // faster than operator>>; the position of the line stream is updated,
+      // so that both can be mixed
+      template< class ENTRY >
+      bool getnextentry( ENTRY &entry, std::true_type )
+      {
+        const std::streamoff offset = line.tellg();
+        if( offset < 0 )
+          return false;
+
+        const char *begin = oneline.c_str() + offset;
+        char *end = nullptr;
+        errno = 0;
+        if( !parseNumber( begin, &end, entry ) || (end == begin) || (errno == ERANGE) )
+        {
+          line.setstate( std::ios_base::failbit );
+          return false;
+        }
+        line.seekg( end - oneline.c_str() );
+        return true;
+      }
+
+      static bool parseNumber ( const char *begin, char **end, double &entry )
+      {
+        entry = std::strtod( begin, end );
+        return true;
+      }
+
+      static bool parseNumber ( const char *begin, char **end, float &entry )
+      {
+        entry = std::strtof( begin, end );
+        return true;
+      }
+
+      static bool parseNumber ( const char *begin, char **end, long double &entry )
+      {
+        entry = std::strtold( begin, end );
+        return true;
+      }
+
+      template< class ENTRY >
+      static bool parseNumber ( const char *begin, char **end, ENTRY &entry )
+      {
+        // integral types: only decimal numbers are accepted, like operator>>
+        if( std::is_signed< ENTRY >::value )
+        {
+          const long long value = std::strtoll( begin, end, 10 );
+          entry = ENTRY( value );
+          return (value >= (long long)std::numeric_limits< ENTRY >::min())
+                 && (value <= (long long)std::numeric_limits< ENTRY >::max());
+        }
+        else
+        {
+          const unsigned long long value = std::strtoull( begin, end, 10 );
+          entry = ENTRY( value );
+          return (value <= (unsigned long long)std::numeric_limits< ENTRY >::max());
+        }
+      }
+
+
     public:
       // search for block in file and store in buffer
       BasicBlock ( std::istream &in, const char* id );
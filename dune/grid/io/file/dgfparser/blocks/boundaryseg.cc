@@ -30,7 +30,7 @@ namespace Dune
 
 
     int BoundarySegBlock
-    :: get( std :: map< EntityKey, BndParam > &facemap,
+    :: get( FaceMap &facemap,
             bool fixedsize,
             int vtxoffset )
     {
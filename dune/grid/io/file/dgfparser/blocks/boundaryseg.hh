@@ -7,7 +7,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <map>
+#include <unordered_map>
 
 #include <dune/grid/io/file/dgfparser/parser.hh>
 #include <dune/grid/io/file/dgfparser/blocks/basic.hh>
@@ -32,13 +32,14 @@ namespace Dune
     public:
       typedef DGFEntityKey< unsigned int> EntityKey;
       typedef std::pair < int, BoundaryParameter > BndParam;
+      typedef std::unordered_map< EntityKey, BndParam, EntityKey::Hash > FaceMap;
 
       // initialize vertex block and get first vertex
       BoundarySegBlock ( std :: istream &in, int pnofvtx,
                          int pdimworld, bool psimplexgrid );
 
       // some information
-      int get( std :: map< EntityKey, BndParam > & facemap,
+      int get( FaceMap &facemap,
                bool fixedsize,
                int vtxoffset
                );
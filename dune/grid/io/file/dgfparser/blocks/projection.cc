@@ -2,6 +2,9 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include <config.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <dune/common/math.hh>
 
 #include <dune/grid/io/file/dgfparser/blocks/projection.hh>
@@ -15,6 +18,9 @@ namespace Dune
     namespace Expr
     {
 
+      typedef ProjectionBlock::Program Program;
+      typedef Program::Operand Operand;
+
       struct ConstantExpression
         : public ProjectionBlock::Expression
       {
@@ -27,6 +33,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         Vector value_;
@@ -37,6 +44,7 @@ namespace Dune
         : public ProjectionBlock::Expression
       {
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
       };
 
 
@@ -50,6 +58,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *function_;
@@ -67,6 +76,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         std::vector< const ProjectionBlock::Expression * > expressions_;
@@ -82,6 +92,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -97,6 +108,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -111,6 +123,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -125,6 +138,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -139,6 +153,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -153,6 +168,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -169,6 +185,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -188,6 +205,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -207,6 +225,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -226,6 +245,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -245,6 +265,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual bool compile ( Program &program, const Operand &argument, Operand &result ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -434,10 +455,305 @@ namespace Dune
           result[ i ] *= factor;
       }
 
+
+
+      // compilation of the expressions
+      // ------------------------------
+
+      // compile a unary operation on a vector of given size
+      inline bool compileUnary ( Program &program, Program::OpCode op, const Operand &a, unsigned int size, Operand &result )
+      {
+        result = program.allocate( size );
+        result.constant = a.constant;
+        program.emit( op, result.offset, a, a );
+        return true;
+      }
+
+      // compile a binary operation with result of given size
+      inline bool compileBinary ( Program &program, Program::OpCode op, const Operand &a, const Operand &b, unsigned int size, Operand &result )
+      {
+        result = program.allocate( size );
+        result.constant = a.constant && b.constant;
+        program.emit( op, result.offset, a, b );
+        return true;
+      }
+
+
+      bool ConstantExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        result = program.constant( value_ );
+        return true;
+      }
+
+
+      bool VariableExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        result = argument;
+        return true;
+      }
+
+
+      bool FunctionCallExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        // the function is inlined with the value of the expression as argument
+        Operand tmp;
+        return expression_->compile( program, argument, tmp ) && function_->compile( program, tmp, result );
+      }
+
+
+      bool VectorExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        std::vector< Operand > components( expressions_.size() );
+        unsigned int size = 0;
+        bool constant = true;
+        for( size_t i = 0; i < expressions_.size(); ++i )
+        {
+          if( !expressions_[ i ]->compile( program, argument, components[ i ] ) )
+            return false;
+          size += components[ i ].size;
+          constant &= components[ i ].constant;
+        }
+
+        result = program.allocate( size );
+        result.constant = constant;
+        unsigned int offset = result.offset;
+        for( size_t i = 0; i < components.size(); ++i )
+        {
+          program.emit( Program::copy, offset, components[ i ], components[ i ] );
+          offset += components[ i ].size;
+        }
+        return true;
+      }
+
+
+      bool BracketExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        if( !expression_->compile( program, argument, result ) || (field_ >= result.size) )
+          return false;
+        result.offset += field_;
+        result.size = 1;
+        return true;
+      }
+
+
+      bool MinusExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a;
+        return expression_->compile( program, argument, a ) && compileUnary( program, Program::negate, a, a.size, result );
+      }
+
+
+      bool NormExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a;
+        return expression_->compile( program, argument, a ) && compileUnary( program, Program::norm, a, 1, result );
+      }
+
+
+      bool SqrtExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a;
+        return expression_->compile( program, argument, a ) && (a.size == 1) && compileUnary( program, Program::sqrt, a, 1, result );
+      }
+
+
+      bool SinExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a;
+        return expression_->compile( program, argument, a ) && (a.size == 1) && compileUnary( program, Program::sin, a, 1, result );
+      }
+
+
+      bool CosExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a;
+        return expression_->compile( program, argument, a ) && (a.size == 1) && compileUnary( program, Program::cos, a, 1, result );
+      }
+
+
+      bool PowerExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a, b;
+        if( !exprA_->compile( program, argument, a ) || !exprB_->compile( program, argument, b ) )
+          return false;
+        return (a.size == 1) && (b.size == 1) && compileBinary( program, Program::power, a, b, 1, result );
+      }
+
+
+      bool SumExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a, b;
+        if( !exprA_->compile( program, argument, a ) || !exprB_->compile( program, argument, b ) )
+          return false;
+        return (a.size == b.size) && compileBinary( program, Program::sum, a, b, a.size, result );
+      }
+
+
+      bool DifferenceExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a, b;
+        if( !exprA_->compile( program, argument, a ) || !exprB_->compile( program, argument, b ) )
+          return false;
+        return (a.size == b.size) && compileBinary( program, Program::difference, a, b, a.size, result );
+      }
+
+
+      bool ProductExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a, b;
+        if( !exprA_->compile( program, argument, a ) || !exprB_->compile( program, argument, b ) )
+          return false;
+        if( a.size == b.size )
+          return compileBinary( program, Program::dot, a, b, 1, result );
+        else if( b.size == 1 )
+          return compileBinary( program, Program::scale, a, b, a.size, result );
+        else if( a.size == 1 )
+          return compileBinary( program, Program::scale, b, a, b.size, result );
+        else
+          return false;
+      }
+
+
+      bool QuotientExpression::compile ( Program &program, const Operand &argument, Operand &result ) const
+      {
+        Operand a, b;
+        if( !exprA_->compile( program, argument, a ) || !exprB_->compile( program, argument, b ) )
+          return false;
+        return (b.size == 1) && compileBinary( program, Program::divide, a, b, a.size, result );
+      }
+
     } // namespace Expr
 
 
 
+    // ProjectionBlock::Program
+    // ------------------------
+
+    ProjectionBlock::Program::Program ( const Expression &expression, int argumentSize )
+    {
+      argument_ = allocate( argumentSize );
+      valid_ = expression.compile( *this, argument_, result_ );
+    }
+
+
+    const double *ProjectionBlock::Program::evaluate ( const double *argument, double *workspace ) const
+    {
+      std::copy( memory_.begin(), memory_.end(), workspace );
+      std::copy( argument, argument + argument_.size, workspace + argument_.offset );
+      const size_t size = code_.size();
+      for( size_t i = 0; i < size; ++i )
+        execute( code_[ i ], workspace );
+      return workspace + result_.offset;
+    }
+
+
+    ProjectionBlock::Program::Operand ProjectionBlock::Program::allocate ( unsigned int size )
+    {
+      Operand operand = { (unsigned int)memory_.size(), size, false };
+      memory_.resize( memory_.size() + size, 0.0 );
+      return operand;
+    }
+
+
+    ProjectionBlock::Program::Operand ProjectionBlock::Program::constant ( const std::vector< double > &value )
+    {
+      Operand operand = allocate( value.size() );
+      std::copy( value.begin(), value.end(), memory_.begin() + operand.offset );
+      operand.constant = true;
+      return operand;
+    }
+
+
+    void ProjectionBlock::Program::emit ( OpCode op, unsigned int result, const Operand &a, const Operand &b )
+    {
+      const Instruction instruction = { op, result, a.offset, b.offset, a.size };
+      if( a.constant && b.constant )
+        execute( instruction, memory_.data() );
+      else
+        code_.push_back( instruction );
+    }
+
+
+    void ProjectionBlock::Program::execute ( const Instruction &instruction, double *memory )
+    {
+      const double *a = memory + instruction.a;
+      const double *b = memory + instruction.b;
+      double *result = memory + instruction.result;
+      const unsigned int size = instruction.size;
+
+      switch( instruction.op )
+      {
+      case copy :
+        for( unsigned int i = 0; i < size; ++i )
+          result[ i ] = a[ i ];
+        break;
+
+      case negate :
+        for( unsigned int i = 0; i < size; ++i )
+          result[ i ] = -a[ i ];
+        break;
+
+      case norm :
+      {
+        double normsqr = 0.0;
+        for( unsigned int i = 0; i < size; ++i )
+          normsqr += a[ i ] * a[ i ];
+        result[ 0 ] = std::sqrt( normsqr );
+        break;
+      }
+
+      case sqrt :
+        result[ 0 ] = std::sqrt( a[ 0 ] );
+        break;
+
+      case sin :
+        result[ 0 ] = std::sin( a[ 0 ] );
+        break;
+
+      case cos :
+        result[ 0 ] = std::cos( a[ 0 ] );
+        break;
+
+      case power :
+        result[ 0 ] = std::pow( a[ 0 ], b[ 0 ] );
+        break;
+
+      case sum :
+        for( unsigned int i = 0; i < size; ++i )
+          result[ i ] = a[ i ] + b[ i ];
+        break;
+
+      case difference :
+        for( unsigned int i = 0; i < size; ++i )
+          result[ i ] = a[ i ] - b[ i ];
+        break;
+
+      case dot :
+      {
+        double product = 0.0;
+        for( unsigned int i = 0; i < size; ++i )
+          product += a[ i ] * b[ i ];
+        result[ 0 ] = product;
+        break;
+      }
+
+      case scale :
+        for( unsigned int i = 0; i < size; ++i )
+          result[ i ] = a[ i ] * b[ 0 ];
+        break;
+
+      case divide :
+      {
+        const double factor = 1.0 / b[ 0 ];
+        for( unsigned int i = 0; i < size; ++i )
+          result[ i ] = a[ i ] * factor;
+        break;
+      }
+      }
+    }
+
+
+
     // ProjectionBlock
     // ---------------
 
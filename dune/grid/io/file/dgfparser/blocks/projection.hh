@@ -4,6 +4,7 @@
 #define DUNE_DGF_PROJECTIONBLOCK_HH
 
 #include <map>
+#include <vector>
 
 #include <dune/grid/common/boundaryprojection.hh>
 #include <dune/grid/io/file/dgfparser/blocks/basic.hh>
@@ -52,6 +53,7 @@ namespace Dune
 
     public:
       struct Expression;
+      class Program;
 
     private:
       template< int dimworld >
@@ -128,6 +130,99 @@ namespace Dune
     std::ostream &operator<< ( std::ostream &out, const ProjectionBlock::Token &token );
 
 
+    /** \brief an expression compiled into a flat program for a fixed argument size
+     *
+     *  The sizes of all intermediate vectors are determined during compilation,
+     *  so that the program works on a memory of fixed size. Subexpressions not
+     *  depending on the argument are evaluated during compilation. If the
+     *  expression cannot be compiled (e.g., due to mismatching vector sizes),
+     *  the program is invalid and the expression has to be evaluated directly.
+     *
+     *  The program only holds the initial memory. Each evaluation works on a
+     *  copy in a workspace of the caller, so the program may be evaluated
+     *  concurrently.
+     */
+    class ProjectionBlock::Program
+    {
+    public:
+      //! a vector in the memory of the program
+      struct Operand
+      {
+        unsigned int offset;
+        unsigned int size;
+        bool constant;
+      };
+
+      enum OpCode
+      {
+        copy, negate, norm, sqrt, sin, cos, power,
+        sum, difference, dot, scale, divide
+      };
+
+      Program ( const Expression &expression, int argumentSize );
+
+      bool valid () const
+      {
+        return valid_;
+      }
+
+      unsigned int resultSize () const
+      {
+        return result_.size;
+      }
+
+      //! number of doubles in the workspace of an evaluation
+      unsigned int memorySize () const
+      {
+        return memory_.size();
+      }
+
+      /** \brief evaluate the program
+       *
+       *  \param[in]  argument   argument of the expression
+       *  \param      workspace  memorySize() doubles, overwritten during the evaluation
+       *
+       *  \returns pointer to the result inside the workspace
+       */
+      const double *evaluate ( const double *argument, double *workspace ) const;
+
+      /** \name Compilation
+       *  \brief Methods used by Expression::compile
+       *  \{
+       */
+
+      //! reserve memory for a vector
+      Operand allocate ( unsigned int size );
+
+      //! store a constant vector in the memory
+      Operand constant ( const std::vector< double > &value );
+
+      /** \brief append an instruction writing to the memory at result
+       *
+       *  The size of the instruction is the size of a. For unary operations, b
+       *  is ignored. If a and b are constant, the instruction is executed
+       *  immediately instead.
+       */
+      void emit ( OpCode op, unsigned int result, const Operand &a, const Operand &b );
+
+      /** \} */
+
+    private:
+      struct Instruction
+      {
+        OpCode op;
+        unsigned int result, a, b, size;
+      };
+
+      static void execute ( const Instruction &instruction, double *memory );
+
+      std::vector< Instruction > code_;
+      std::vector< double > memory_;
+      Operand argument_, result_;
+      bool valid_;
+    };
+
+
     struct ProjectionBlock::Expression
     {
       typedef std::vector< double > Vector;
@@ -136,6 +231,19 @@ namespace Dune
       {}
 
       virtual void evaluate ( const Vector &argument, Vector &result ) const = 0;
+
+      /** \brief append the instructions evaluating this expression to a program
+       *
+       *  \param      program   program to append the instructions to
+       *  \param[in]  argument  location of the argument in the memory of the program
+       *  \param[out] result    location of the result in the memory of the program
+       *
+       *  \returns false if the expression cannot be compiled
+       */
+      virtual bool compile ( Program &program, const Program::Operand &argument, Program::Operand &result ) const
+      {
+        return false;
+      }
     };
 
 
@@ -149,17 +257,38 @@ namespace Dune
       typedef typename Base::CoordinateType CoordinateType;
 
       BoundaryProjection ( const Expression *expression )
-        : expression_( expression )
+        : expression_( expression ),
+          program_( *expression, dimworld )
       {}
 
       virtual CoordinateType operator() ( const CoordinateType &global ) const
       {
+        CoordinateType result;
+        if( program_.valid() && (program_.resultSize() >= dimworld) )
+        {
+          double x[ dimworld ];
+          for( int i = 0; i < dimworld; ++i )
+            x[ i ] = global[ i ];
+          // each call needs its own workspace, small ones live on the stack
+          double buffer[ 64 ];
+          std::vector< double > heap;
+          double *workspace = buffer;
+          if( program_.memorySize() > 64 )
+          {
+            heap.resize( program_.memorySize() );
+            workspace = heap.data();
+          }
+          const double *y = program_.evaluate( x, workspace );
+          for( int i = 0; i < dimworld; ++i )
+            result[ i ] = y[ i ];
+          return result;
+        }
+
         std::vector< double > x( dimworld );
         for( int i = 0; i < dimworld; ++i )
           x[ i ] = global[ i ];
         std::vector< double > y;
         expression_->evaluate( x, y );
-        CoordinateType result;
         for( int i = 0; i < dimworld; ++i )
           result[ i ] = y[ i ];
         return result;
@@ -167,6 +296,7 @@ namespace Dune
 
     private:
       const Expression *expression_;
+      Program program_;
     };
 
   }
@@ -2,7 +2,15 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include <config.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <utility>
 #if HAVE_MKSTEMP
 #include <unistd.h>
 #endif
@@ -20,6 +28,96 @@ namespace Dune
   static const std::string dgfid( "DGF" );
 
 
+  // DGF cache
+  // ---------
+
+  namespace
+  {
+
+    static const char dgfCacheMagic[ 8 ] = { 'D', 'G', 'F', 'C', 'A', 'C', 'H', 'E' };
+    static const std::uint32_t dgfCacheVersion = 1;
+
+    template< class T >
+    void writeCacheValue ( std::ostream &out, const T &value )
+    {
+      out.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+    }
+
+    void writeCacheValue ( std::ostream &out, const std::string &value )
+    {
+      writeCacheValue( out, std::uint64_t( value.size() ) );
+      out.write( value.data(), value.size() );
+    }
+
+    template< class T >
+    void writeCacheValue ( std::ostream &out, const std::vector< T > &value )
+    {
+      writeCacheValue( out, std::uint64_t( value.size() ) );
+      out.write( reinterpret_cast< const char * >( value.data() ), value.size()*sizeof( T ) );
+    }
+
+    template< class T >
+    void writeCacheValue ( std::ostream &out, const std::vector< std::vector< T > > &value )
+    {
+      writeCacheValue( out, std::uint64_t( value.size() ) );
+      for( const std::vector< T > &v : value )
+        writeCacheValue( out, v );
+    }
+
+    template< class T >
+    bool readCacheValue ( std::istream &in, T &value )
+    {
+      return bool( in.read( reinterpret_cast< char * >( &value ), sizeof( T ) ) );
+    }
+
+    // read the size of a container, which cannot exceed the remaining bytes
+    bool readCacheSize ( std::istream &in, std::size_t &size, std::uint64_t remaining )
+    {
+      std::uint64_t value;
+      if( !readCacheValue( in, value ) || (value > remaining) )
+        return false;
+      size = value;
+      return true;
+    }
+
+    bool readCacheValue ( std::istream &in, std::string &value, std::uint64_t remaining )
+    {
+      std::size_t size;
+      if( !readCacheSize( in, size, remaining ) )
+        return false;
+      value.resize( size );
+      return bool( in.read( &value[ 0 ], size ) );
+    }
+
+    template< class T >
+    bool readCacheValue ( std::istream &in, std::vector< T > &value, std::uint64_t remaining )
+    {
+      std::size_t size;
+      if( !readCacheSize( in, size, remaining / sizeof( T ) ) )
+        return false;
+      value.resize( size );
+      return bool( in.read( reinterpret_cast< char * >( value.data() ), size*sizeof( T ) ) );
+    }
+
+    template< class T >
+    bool readCacheValue ( std::istream &in, std::vector< std::vector< T > > &value, std::uint64_t remaining )
+    {
+      std::size_t size;
+      if( !readCacheSize( in, size, remaining / sizeof( std::uint64_t ) ) )
+        return false;
+      value.resize( size );
+      for( std::vector< T > &v : value )
+      {
+        if( !readCacheValue( in, v, remaining ) )
+          return false;
+      }
+      return true;
+    }
+
+  } // namespace
+
+
+
   class DGFPrintInfo
   {
     std::ofstream out;
@@ -116,6 +214,19 @@ namespace Dune
   }
 
 
+  std::vector< DuneGridFormatParser::facemap_t::const_iterator > DuneGridFormatParser::sortedFaces () const
+  {
+    std::vector< facemap_t::const_iterator > faces;
+    faces.reserve( facemap.size() );
+    for( facemap_t::const_iterator pos = facemap.begin(); pos != facemap.end(); ++pos )
+      faces.push_back( pos );
+    std::sort( faces.begin(), faces.end(), [] ( const facemap_t::const_iterator &a, const facemap_t::const_iterator &b ) {
+                 return a->first < b->first;
+               } );
+    return faces;
+  }
+
+
   // Output to Tetgen/Triangle poly-file
   void DuneGridFormatParser
   ::writeTetgenPoly ( const std::string &prefixname, std::string &extension, std::string &params )
@@ -170,11 +281,10 @@ namespace Dune
         }
         {
           std::ofstream out( (name + ".face").c_str() );
-          facemap_t :: iterator pos;
           int nr = 0;
           dverb << "Writing boundary faces...";
           out << facemap.size() << " 1 " << std::endl;
-          for(pos= facemap.begin(); pos!=facemap.end(); ++pos) {
+          for( const facemap_t::const_iterator &pos : sortedFaces() ) {
             out << nr++ << " ";
             for (int i=0; i<pos->first.size(); i++)
               out << pos->first.origKey(i) << " ";
@@ -220,7 +330,7 @@ namespace Dune
       }
 
       // write out boundary segments
-      for( facemap_t::iterator pos = facemap.begin(); pos != facemap.end(); ++pos, ++nr )
+      for( const facemap_t::const_iterator &pos : sortedFaces() )
       {
         if( dimw == 3 )
         {
@@ -234,6 +344,7 @@ namespace Dune
         if( dimw == 2 )
           out << " " << pos->second.first;
         out << std::endl;
+        ++nr;
       }
       out << "0" << std::endl;
 
@@ -293,7 +404,7 @@ namespace Dune
   }
 
 
-  bool DuneGridFormatParser::readDuneGrid ( std::istream &gridin, int dimG, int dimW )
+  bool DuneGridFormatParser::readDuneGrid ( std::istream &gridin, int dimG, int dimW, const Cache &cache )
   {
     if( !isDuneGridFormat( gridin ) )
     {
@@ -303,6 +414,19 @@ namespace Dune
       return false;
     } // not a DGF file, prehaps native file format
 
+    // use the cache, if it matches the input
+    const std::string &cacheFileName = cache.fileName;
+    std::string cacheHeader;
+    if( !cacheFileName.empty() )
+    {
+      std::ostringstream header;
+      header << cache.gridType << " " << dimG << " " << dimW << " " << element << " "
+             << minVertexDistance << " " << hash( gridin );
+      cacheHeader = header.str();
+      if( readCache( cacheFileName, cacheHeader ) )
+        return true;
+    }
+
     // initialize variables
     cube2simplex = false;
     simplexgrid = false;
@@ -456,43 +580,253 @@ namespace Dune
     info->finish();
     delete info;
     info = 0;
+
+    if( !cacheFileName.empty() && (rank_ == 0) )
+      writeCache( cacheFileName, cacheHeader );
+
     // we made it -
     // although prehaps a few boundary segments are still without id :-<
     return true;
   }
 
 
-  void DuneGridFormatParser :: removeCopies ()
+  std::uint64_t DuneGridFormatParser::hash ( std::istream &input )
+  {
+    // 64 bit FNV-1a hash of the content and its size
+    std::uint64_t hash = 14695981039346656037ull, size = 0;
+    input.clear();
+    input.seekg( 0 );
+    char buffer[ 4096 ];
+    while( input )
+    {
+      input.read( buffer, sizeof( buffer ) );
+      const std::streamsize count = input.gcount();
+      for( std::streamsize i = 0; i < count; ++i )
+        hash = (hash ^ static_cast< unsigned char >( buffer[ i ] )) * 1099511628211ull;
+      size += count;
+    }
+    input.clear();
+    input.seekg( 0 );
+    return hash ^ size;
+  }
+
+
+  bool DuneGridFormatParser::readCache ( const std::string &fileName, const std::string &header )
+  {
+    std::ifstream in( fileName, std::ios::binary );
+    if( !in )
+      return false;
+
+    // all sizes are bounded by the size of the file to reject corrupted caches
+    in.seekg( 0, std::ios::end );
+    const std::uint64_t remaining = in.tellg();
+    in.seekg( 0 );
+
+    char magic[ sizeof( dgfCacheMagic ) ];
+    std::uint32_t version;
+    std::string cacheHeader;
+    if( !in.read( magic, sizeof( magic ) ) || !std::equal( magic, magic + sizeof( magic ), dgfCacheMagic )
+        || !readCacheValue( in, version ) || (version != dgfCacheVersion)
+        || !readCacheValue( in, cacheHeader, remaining ) || (cacheHeader != header) )
+      return false;
+
+    // read into temporary containers, so that an invalid cache leaves the parser untouched
+    std::int32_t values[ 9 ];
+    std::vector< std::vector< double > > cacheVtx, cacheVtxParams, cacheElParams;
+    std::vector< std::vector< unsigned int > > cacheElements;
+    std::uint64_t nofFaces;
+    if( !readCacheValue( in, values ) || !readCacheValue( in, cacheVtx, remaining )
+        || !readCacheValue( in, cacheElements, remaining ) || !readCacheValue( in, cacheVtxParams, remaining )
+        || !readCacheValue( in, cacheElParams, remaining ) || !readCacheValue( in, nofFaces ) )
+      return false;
+
+    facemap_t cacheFacemap;
+    for( std::uint64_t i = 0; i < nofFaces; ++i )
+    {
+      std::vector< unsigned int > key;
+      char origKeySet;
+      std::int32_t id;
+      BoundaryParameter parameter;
+      if( !readCacheValue( in, key, remaining ) || !readCacheValue( in, origKeySet )
+          || !readCacheValue( in, id ) || !readCacheValue( in, parameter, remaining ) )
+        return false;
+      cacheFacemap.insert( std::make_pair( DGFEntityKey< unsigned int >( key, origKeySet != 0 ), BndParam( id, parameter ) ) );
+    }
+
+    vtx.swap( cacheVtx );
+    elements.swap( cacheElements );
+    vtxParams.swap( cacheVtxParams );
+    elParams.swap( cacheElParams );
+    facemap.swap( cacheFacemap );
+    dimw = values[ 0 ];
+    dimgrid = values[ 1 ];
+    nofvtx = values[ 2 ];
+    vtxoffset = values[ 3 ];
+    nofelements = values[ 4 ];
+    nofbound = values[ 5 ];
+    nofvtxparams = values[ 6 ];
+    nofelparams = values[ 7 ];
+    haveBndParameters = (values[ 8 ] & 1) != 0;
+    simplexgrid = (values[ 8 ] & 2) != 0;
+    cube2simplex = (values[ 8 ] & 4) != 0;
+    return true;
+  }
+
+
+  void DuneGridFormatParser::writeCache ( const std::string &fileName, const std::string &header ) const
   {
-    std::vector<int> map(vtx.size());
-    std::vector<int> shift(vtx.size());
-    for (size_t i=0; i<vtx.size(); i++) {
-      map[i]=i;
-      shift[i]=0;
+    // write to a unique temporary file first, so that concurrent writers do not
+    // interfere and readers never see a partial cache
+#if HAVE_MKSTEMP
+    std::vector< char > tmpName( fileName.begin(), fileName.end() );
+    const std::string suffix( ".XXXXXX" );
+    tmpName.insert( tmpName.end(), suffix.begin(), suffix.end() );
+    tmpName.push_back( '\0' );
+    const int fd = mkstemp( tmpName.data() );
+    if( fd < 0 )
+    {
+      dwarn << "Unable to write DGF cache '" << fileName << "'." << std::endl;
+      return;
     }
-    nofvtx = vtx.size();
-    for (size_t i=0; i<vtx.size(); i++) {
-      if ((size_t)map[i]!=i) continue;
-      for (size_t j=i+1; j<vtx.size(); j++) {
-        double len=std::abs(vtx[i][0]-vtx[j][0]);
-        for (int p=1; p<dimw; p++)
-          len+=std::abs(vtx[i][p]-vtx[j][p]);
-        if (len<minVertexDistance) {
-          map[j]=i;
-          for (size_t k=j+1; k<vtx.size(); k++)
-            shift[k]++;
-          nofvtx--;
+    close( fd );
+    const std::string tmpFileName( tmpName.data() );
+#else
+    const std::string tmpFileName = fileName + ".tmp" + std::to_string( std::random_device()() );
+#endif
+    {
+      std::ofstream out( tmpFileName, std::ios::binary );
+      if( !out )
+      {
+        dwarn << "Unable to write DGF cache '" << fileName << "'." << std::endl;
+        return;
+      }
+
+      out.write( dgfCacheMagic, sizeof( dgfCacheMagic ) );
+      writeCacheValue( out, dgfCacheVersion );
+      writeCacheValue( out, header );
+
+      const std::int32_t flags = (haveBndParameters ? 1 : 0) | (simplexgrid ? 2 : 0) | (cube2simplex ? 4 : 0);
+      const std::int32_t values[ 9 ] = { dimw, dimgrid, nofvtx, vtxoffset, nofelements, nofbound, nofvtxparams, nofelparams, flags };
+      writeCacheValue( out, values );
+      writeCacheValue( out, vtx );
+      writeCacheValue( out, elements );
+      writeCacheValue( out, vtxParams );
+      writeCacheValue( out, elParams );
+
+      writeCacheValue( out, std::uint64_t( facemap.size() ) );
+      std::vector< unsigned int > key;
+      for( const facemap_t::const_iterator &face : sortedFaces() )
+      {
+        key.resize( face->first.size() );
+        for( std::size_t i = 0; i < key.size(); ++i )
+          key[ i ] = face->first.origKey( i );
+        writeCacheValue( out, key );
+        writeCacheValue( out, char( face->first.origKeySet() ) );
+        writeCacheValue( out, std::int32_t( face->second.first ) );
+        writeCacheValue( out, face->second.second );
+      }
+
+      if( !out )
+      {
+        dwarn << "Unable to write DGF cache '" << fileName << "'." << std::endl;
+        std::remove( tmpFileName.c_str() );
+        return;
+      }
+    }
+    if( std::rename( tmpFileName.c_str(), fileName.c_str() ) != 0 )
+    {
+      dwarn << "Unable to write DGF cache '" << fileName << "'." << std::endl;
+      std::remove( tmpFileName.c_str() );
+    }
+  }
+
+
+  void DuneGridFormatParser :: removeCopies ()
+  {
+    // Vertices closer than minVertexDistance (in the L^1 norm) differ by less
+    // than the cell size in each coordinate, so copies of a vertex can only
+    // lie in the same or a neighboring cell of a uniform grid. The cells are
+    // identified by a hash of their integer coordinates; collisions only add
+    // candidates that are rejected by the distance check.
+    if( vtx.empty() )
+      return;
+
+    double extent = 0;
+    for( size_t i = 0; i < vtx.size(); ++i )
+      for( int p = 0; p < dimw; ++p )
+        extent = std::max( extent, std::abs( vtx[ i ][ p ] ) );
+    // limit the number of cells per direction to keep the integer coordinates in range
+    double cellSize = std::max( minVertexDistance, 1e-9 * extent );
+    if( !(cellSize > 0) )
+      cellSize = 1;
+
+    auto cellHash = [ this ] ( const std::vector< long long > &cell ) {
+        std::size_t hash = 0;
+        for( int p = 0; p < dimw; ++p )
+          hash ^= std::hash< long long >()( cell[ p ] ) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+      };
+
+    // the kept vertices, sorted into the cells
+    std::unordered_multimap< std::size_t, int > cells;
+    cells.reserve( vtx.size() );
+
+    std::vector< int > map( vtx.size() );
+    std::vector< bool > keep( vtx.size(), false );
+    std::vector< long long > cell( dimw ), neighbor( dimw );
+    nofvtx = 0;
+    for( size_t j = 0; j < vtx.size(); ++j )
+    {
+      for( int p = 0; p < dimw; ++p )
+        cell[ p ] = static_cast< long long >( std::floor( vtx[ j ][ p ] / cellSize ) );
+
+      // search the 3^dimw neighboring cells for the first kept vertex close to vtx[ j ]
+      int copyOf = -1;
+      std::vector< int > offset( dimw, -1 );
+      for( bool done = false; !done; )
+      {
+        for( int p = 0; p < dimw; ++p )
+          neighbor[ p ] = cell[ p ] + offset[ p ];
+        const auto range = cells.equal_range( cellHash( neighbor ) );
+        for( auto it = range.first; it != range.second; ++it )
+        {
+          const std::vector< double > &v = vtx[ it->second ];
+          double len = 0;
+          for( int p = 0; p < dimw; ++p )
+            len += std::abs( v[ p ] - vtx[ j ][ p ] );
+          if( (len < minVertexDistance) && ((copyOf < 0) || (map[ it->second ] < map[ copyOf ])) )
+            copyOf = it->second;
+        }
+
+        done = true;
+        for( int p = 0; p < dimw; ++p )
+        {
+          if( ++offset[ p ] <= 1 )
+          {
+            done = false;
+            break;
+          }
+          offset[ p ] = -1;
         }
       }
+
+      if( copyOf >= 0 )
+        map[ j ] = map[ copyOf ];
+      else
+      {
+        map[ j ] = nofvtx++;
+        keep[ j ] = true;
+        cells.insert( std::make_pair( cellHash( cell ), int( j ) ) );
+      }
     }
+
     for (size_t i=0; i<elements.size(); i++) {
-      for (size_t j=0; j<elements[i].size(); j++) {
+      for (size_t j=0; j<elements[i].size(); j++)
         elements[i][j]=map[elements[i][j]];
-        elements[i][j]-=shift[elements[i][j]];
-      }
     }
     for (size_t j=0; j<vtx.size(); j++) {
-      vtx[j-shift[j]]=vtx[j];
+      if (keep[j])
+        vtx[map[j]]=vtx[j];
     }
     vtx.resize(nofvtx);
     assert(vtx.size()==size_t(nofvtx));
@@ -92,11 +92,11 @@ namespace Dune
 
 #if ENABLE_UG
   template< int dim >
-  void DGFGridFactory< UGGrid< dim > >::generate ( std::istream &input )
+  void DGFGridFactory< UGGrid< dim > >::generate ( std::istream &input, const DuneGridFormatParser::Cache &cache )
   {
     dgf_.element = DuneGridFormatParser::General;
 
-    if( !dgf_.readDuneGrid( input, dim, dim ) )
+    if( !dgf_.readDuneGrid( input, dim, dim, cache ) )
       DUNE_THROW( DGFException, "Error: Failed to build grid");
 
     dgf_.setOrientation( 0, 1 );
@@ -154,8 +154,8 @@ namespace Dune
   }
 
 
-  template void DGFGridFactory< UGGrid< 2 > >::generate ( std::istream &input );
-  template void DGFGridFactory< UGGrid< 3 > >::generate ( std::istream &input );
+  template void DGFGridFactory< UGGrid< 2 > >::generate ( std::istream &input, const DuneGridFormatParser::Cache &cache );
+  template void DGFGridFactory< UGGrid< 3 > >::generate ( std::istream &input, const DuneGridFormatParser::Cache &cache );
 #endif // #if ENABLE_UG
 
 } // namespace Dune
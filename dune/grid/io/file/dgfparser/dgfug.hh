@@ -95,9 +95,10 @@ namespace Dune
       generate( input );
     }
 
-    /** \brief constructor taking filename */
+    /** \brief constructor taking filename, optionally using a binary cache of the macro grid */
     explicit DGFGridFactory ( const std::string &filename,
-                              MPICommunicatorType comm = MPIHelper::getCommunicator() )
+                              MPICommunicatorType comm = MPIHelper::getCommunicator(),
+                              const DuneGridFormatParser::Cache &cache = DuneGridFormatParser::Cache() )
       : grid_( 0 ),
         factory_(),
         dgf_( rank( comm ), size( comm ) )
@@ -105,7 +106,7 @@ namespace Dune
       std::ifstream input( filename.c_str() );
       if ( !input )
         DUNE_THROW( DGFException, "Error: Macrofile " << filename << " not found" );
-      generate( input );
+      generate( input, cache );
     }
 
     /** \brief return grid */
@@ -203,7 +204,7 @@ namespace Dune
 
   private:
     // create grid
-    void generate ( std::istream &input );
+    void generate ( std::istream &input, const DuneGridFormatParser::Cache &cache = DuneGridFormatParser::Cache() );
 
     // return rank
     static int rank( MPICommunicatorType MPICOMM )
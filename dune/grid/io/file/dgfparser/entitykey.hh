@@ -3,6 +3,8 @@
 #ifndef DUNE_DGFEnTITYKEY_HH
 #define DUNE_DGFEnTITYKEY_HH
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <vector>
 
@@ -26,6 +28,7 @@ namespace Dune
 
     inline const A &operator[] ( int i ) const;
     inline bool operator < ( const DGFEntityKey< A > &k ) const;
+    inline bool operator== ( const DGFEntityKey< A > &k ) const;
 
     void orientation ( int base, std :: vector< std :: vector< double > > &vtx );
     void print( std :: ostream &out = std :: cerr ) const;
@@ -34,6 +37,18 @@ namespace Dune
     inline const A &origKey ( int i ) const;
     inline int size () const;
 
+    //! hash of the sorted key, for use in unordered containers
+    struct Hash
+    {
+      std::size_t operator() ( const DGFEntityKey< A > &k ) const
+      {
+        std::size_t hash = k.key_.size();
+        for( const A &a : k.key_ )
+          hash ^= std::hash< A >()( a ) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+      }
+    };
+
   private:
     std :: vector< A > key_, origKey_;
     bool origKeySet_;
@@ -55,6 +70,13 @@ namespace Dune
   }
 
 
+  template< class A >
+  inline bool DGFEntityKey< A > :: operator== ( const DGFEntityKey< A > &k ) const
+  {
+    return key_ == k.key_;
+  }
+
+
   template< class A >
   inline bool DGFEntityKey< A > :: origKeySet () const
   {
@@ -9,8 +9,10 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <type_traits>
 
 //- Dune includes
+#include <dune/common/classname.hh>
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/shared_ptr.hh>
 
@@ -128,6 +130,33 @@ namespace Dune
       initialize( dgfFactory );
     }
 
+    /** \brief constructor given the name of a DGF file, optionally using a cache
+     *
+     *  If useCache is true, the parsed macro grid is stored in the binary file
+     *  filename.cache and read from there on the next construction, as long
+     *  as neither the DGF file nor the grid type change
+     *  (see DuneGridFormatParser::Cache). Grids whose DGF factory does not
+     *  build on DuneGridFormatParser::readDuneGrid ignore the cache.
+     */
+    GridPtr ( const std::string &filename, MPICommunicatorType comm, bool useCache )
+      : gridPtr_(),
+        elParam_(),
+        vtxParam_(),
+        bndParam_(),
+        bndId_(),
+        emptyParam_(),
+        nofElParam_( 0 ),
+        nofVtxParam_( 0 ),
+        haveBndParam_( false )
+    {
+      DuneGridFormatParser::Cache cache;
+      if( useCache )
+        cache = DuneGridFormatParser::Cache( filename + ".cache", className< GridType >() );
+      initialize( filename, comm, cache,
+                  std::is_constructible< DGFGridFactory< GridType >, const std::string &, MPICommunicatorType,
+                                         const DuneGridFormatParser::Cache & >() );
+    }
+
     //! constructor given a std::istream
     explicit GridPtr ( std::istream &input,
                        MPICommunicatorType comm = MPIHelper::getCommunicator() )
@@ -318,6 +347,22 @@ namespace Dune
     }
 
   protected:
+    // the DGF factory of the grid takes a cache
+    void initialize ( const std::string &filename, MPICommunicatorType comm,
+                      const DuneGridFormatParser::Cache &cache, std::true_type )
+    {
+      DGFGridFactory< GridType > dgfFactory( filename, comm, cache );
+      initialize( dgfFactory );
+    }
+
+    // the DGF factory of the grid does not use a cache
+    void initialize ( const std::string &filename, MPICommunicatorType comm,
+                      const DuneGridFormatParser::Cache &cache, std::false_type )
+    {
+      DGFGridFactory< GridType > dgfFactory( filename, comm );
+      initialize( dgfFactory );
+    }
+
     void initialize ( DGFGridFactory< GridType > &dgfFactory )
     {
       gridPtr_ = mygrid_ptr( dgfFactory.grid() );
@@ -3,10 +3,12 @@
 #ifndef DUNE_DGF_DUNEGRIDFORMATPARSER_HH
 #define DUNE_DGF_DUNEGRIDFORMATPARSER_HH
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include <dune/grid/io/file/dgfparser/entitykey.hh>
 
@@ -74,6 +76,32 @@ namespace Dune
      */
     static bool isDuneGridFormat ( const std::string &filename );
 
+    /** \brief binary cache for readDuneGrid
+     *
+     *  If a cache file is given, readDuneGrid stores the vertices, elements,
+     *  boundary ids and parameters it has read in it. Later calls with the
+     *  same input and the same grid type read them from the cache instead of
+     *  parsing the input. The cache is validated by a hash of the input, the
+     *  dimensions, the element type and the name of the grid type, and it is
+     *  rewritten if any of them differ.
+     *
+     *  \note Only grids constructed via readDuneGrid (e.g., UGGrid and AlbertaGrid)
+     *        make use of the cache.
+     */
+    struct Cache
+    {
+      Cache () = default;
+
+      Cache ( const std::string &fileName, const std::string &gridType )
+        : fileName( fileName ), gridType( gridType )
+      {}
+
+      //! name of the cache file, no cache is used if it is empty
+      std::string fileName;
+      //! name of the grid type the cache is written for
+      std::string gridType;
+    };
+
     /** \brief parse dune grid format from stream
      *
      *  This method actually fills the vtx, element, and bound vectors.
@@ -81,12 +109,13 @@ namespace Dune
      *  \param      input  std::istream to read the grid from
      *  \param[in]  dimG   dimension of the grid (i.e., Grid::dimension)
      *  \param[in]  dimW   dimension of the world (i.e., Grid::dimensionworld)
+     *  \param[in]  cache  binary cache of the result (see Cache), disabled by default
      *
      *  \note The stream must support seeking.
      *
      *  \returns whether reading succeeded
      */
-    bool readDuneGrid( std::istream &input, int dimG, int dimW );
+    bool readDuneGrid( std::istream &input, int dimG, int dimW, const Cache &cache = Cache() );
 
     //! method to write in Tetgen/Triangle Poly Format
     void writeTetgenPoly ( const std::string &, std::string &, std::string & );
@@ -96,6 +125,15 @@ namespace Dune
   protected:
     void generateBoundaries ( std::istream &, bool );
 
+    // hash of the content of the stream, used to validate the cache
+    static std::uint64_t hash ( std::istream & );
+
+    // read the result of readDuneGrid from the cache, returns false if the cache is not valid
+    bool readCache ( const std::string &fileName, const std::string &header );
+
+    // write the result of readDuneGrid to the cache
+    void writeCache ( const std::string &fileName, const std::string &header ) const;
+
     // call to tetgen/triangle
     void generateSimplexGrid ( std::istream & );
     void readTetgenTriangle ( const std::string & );
@@ -141,9 +179,12 @@ namespace Dune
     // map to generate and find boundary segments
     typedef DGFBoundaryParameter::type BoundaryParameter;
     typedef std::pair < int, BoundaryParameter > BndParam;
-    typedef std::map< DGFEntityKey< unsigned int >, BndParam > facemap_t;
+    typedef std::unordered_map< DGFEntityKey< unsigned int >, BndParam, DGFEntityKey< unsigned int >::Hash > facemap_t;
     facemap_t facemap;
 
+    // boundary faces sorted by their key, so that output does not depend on the hash order
+    std::vector< facemap_t::const_iterator > sortedFaces () const;
+
     // true if parameters on a boundary found
     bool haveBndParameters;
 
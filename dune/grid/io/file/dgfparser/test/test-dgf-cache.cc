@@ -0,0 +1,176 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/io/file/dgfparser/dgfparser.hh>
+
+/** \file
+ * \brief Check the binary cache of the DGF parser
+ *
+ * Each DGF file is parsed without cache, with an empty cache and with the
+ * cache written by the previous run. All three parsers have to return the
+ * same macro grid. Changes of the input and corrupted caches must not be
+ * served from the cache.
+ */
+
+using namespace Dune;
+
+const std::string cacheFileName( "test-dgf-cache.cache" );
+
+// gives access to the macro grid stored in the parser
+struct Parser
+  : public DuneGridFormatParser
+{
+  Parser () : DuneGridFormatParser( 0, 1 ) {}
+
+  using DuneGridFormatParser::dimw;
+  using DuneGridFormatParser::dimgrid;
+  using DuneGridFormatParser::vtx;
+  using DuneGridFormatParser::nofvtx;
+  using DuneGridFormatParser::vtxoffset;
+  using DuneGridFormatParser::elements;
+  using DuneGridFormatParser::nofelements;
+  using DuneGridFormatParser::nofbound;
+  using DuneGridFormatParser::facemap;
+  using DuneGridFormatParser::haveBndParameters;
+  using DuneGridFormatParser::element;
+  using DuneGridFormatParser::simplexgrid;
+  using DuneGridFormatParser::cube2simplex;
+  using DuneGridFormatParser::nofvtxparams;
+  using DuneGridFormatParser::nofelparams;
+  using DuneGridFormatParser::vtxParams;
+  using DuneGridFormatParser::elParams;
+};
+
+std::string readFile ( const std::string &fileName )
+{
+  std::ifstream in( fileName, std::ios::binary );
+  return std::string( std::istreambuf_iterator< char >( in ), std::istreambuf_iterator< char >() );
+}
+
+void parse ( Parser &parser, const std::string &content, int dimG, int dimW, DuneGridFormatParser::element_t element,
+             const DuneGridFormatParser::Cache &cache )
+{
+  std::istringstream input( content );
+  parser.element = element;
+  if( !parser.readDuneGrid( input, dimG, dimW, cache ) )
+    DUNE_THROW( GridError, "Could not parse DGF input" );
+}
+
+void compare ( const Parser &a, const Parser &b, const std::string &name )
+{
+  if( (a.dimw != b.dimw) || (a.dimgrid != b.dimgrid) || (a.nofvtx != b.nofvtx) || (a.vtxoffset != b.vtxoffset)
+      || (a.nofelements != b.nofelements) || (a.nofbound != b.nofbound) || (a.haveBndParameters != b.haveBndParameters)
+      || (a.simplexgrid != b.simplexgrid) || (a.cube2simplex != b.cube2simplex)
+      || (a.nofvtxparams != b.nofvtxparams) || (a.nofelparams != b.nofelparams) )
+    DUNE_THROW( GridError, name << ": Cached sizes differ" );
+
+  if( (a.vtx != b.vtx) || (a.elements != b.elements) || (a.vtxParams != b.vtxParams) || (a.elParams != b.elParams) )
+    DUNE_THROW( GridError, name << ": Cached vertices or elements differ" );
+
+  if( a.facemap.size() != b.facemap.size() )
+    DUNE_THROW( GridError, name << ": Cached number of boundary faces differs" );
+  for( const auto &face : a.facemap )
+  {
+    const auto pos = b.facemap.find( face.first );
+    if( (pos == b.facemap.end()) || (pos->first.origKeySet() != face.first.origKeySet()) || (pos->second != face.second) )
+      DUNE_THROW( GridError, name << ": Cached boundary faces differ" );
+    for( int i = 0; i < face.first.size(); ++i )
+    {
+      if( pos->first.origKey( i ) != face.first.origKey( i ) )
+        DUNE_THROW( GridError, name << ": Cached boundary faces differ" );
+    }
+  }
+}
+
+void check ( const std::string &fileName, int dimG, int dimW, DuneGridFormatParser::element_t element )
+{
+  std::ifstream file( std::string( DUNE_GRID_EXAMPLE_GRIDS_PATH ) + "dgf/" + fileName );
+  if( !file )
+    DUNE_THROW( IOError, "Could not open " << fileName );
+  std::ostringstream content;
+  content << file.rdbuf();
+
+  std::remove( cacheFileName.c_str() );
+  const DuneGridFormatParser::Cache setting( cacheFileName, "test" );
+
+  Timer watch;
+  Parser reference;
+  parse( reference, content.str(), dimG, dimW, element, DuneGridFormatParser::Cache() );
+  const double parseTime = watch.elapsed();
+
+  Parser writer;
+  parse( writer, content.str(), dimG, dimW, element, setting );
+  compare( reference, writer, fileName );
+  if( !std::ifstream( cacheFileName ) )
+    DUNE_THROW( GridError, fileName << ": Cache file was not written" );
+
+  watch.reset();
+  Parser reader;
+  parse( reader, content.str(), dimG, dimW, element, setting );
+  const double cacheTime = watch.elapsed();
+  compare( reference, reader, fileName );
+
+  std::cout << fileName << ": parsed in " << parseTime << " s, read from cache in " << cacheTime << " s" << std::endl;
+
+  // another grid type or a modified input must not use the cache, but rewrite it
+  const std::string cache = readFile( cacheFileName );
+  {
+    Parser parser;
+    parse( parser, content.str(), dimG, dimW, element, DuneGridFormatParser::Cache( cacheFileName, "other" ) );
+    compare( reference, parser, fileName + " (other grid type)" );
+    if( readFile( cacheFileName ) == cache )
+      DUNE_THROW( GridError, fileName << ": Cache was not rewritten for another grid type" );
+  }
+  {
+    Parser parser;
+    parse( parser, content.str() + "\n% modified\n", dimG, dimW, element, setting );
+    compare( reference, parser, fileName + " (modified)" );
+    if( readFile( cacheFileName ) == cache )
+      DUNE_THROW( GridError, fileName << ": Cache was not rewritten for modified input" );
+  }
+
+  // a truncated cache must be ignored
+  {
+    std::ofstream( cacheFileName, std::ios::binary ).write( cache.data(), cache.size() / 2 );
+    Parser parser;
+    parse( parser, content.str(), dimG, dimW, element, setting );
+    compare( reference, parser, fileName + " (truncated cache)" );
+    if( readFile( cacheFileName ) != cache )
+      DUNE_THROW( GridError, fileName << ": Truncated cache was not rewritten" );
+  }
+
+  std::remove( cacheFileName.c_str() );
+}
+
+int main ()
+try
+{
+  check( "examplegrid5.dgf", 2, 2, DuneGridFormatParser::Simplex );
+  check( "examplegrid10.dgf", 3, 3, DuneGridFormatParser::General );
+  check( "test2d.dgf", 2, 2, DuneGridFormatParser::Cube );
+  check( "test3d.dgf", 3, 3, DuneGridFormatParser::General );
+  check( "unstr_cube.dgf", 2, 2, DuneGridFormatParser::General );
+  check( "simplex-testgrid-3-3-large.dgf", 3, 3, DuneGridFormatParser::Simplex );
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch (...)
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 1;
+}
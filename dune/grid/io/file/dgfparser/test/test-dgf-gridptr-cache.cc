@@ -0,0 +1,110 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/io/file/dgfparser/dgfparser.hh>
+#include <dune/grid/io/file/dgfparser/dgfug.hh>
+
+/** \file
+ * \brief Check the GridPtr constructor that uses the binary cache of the DGF parser
+ *
+ * A DGF file is read into a UGGrid without cache, with an empty cache and
+ * from the cache written before. All three grids must have the same
+ * elements, vertices and element, vertex and boundary parameters.
+ */
+
+using namespace Dune;
+
+typedef UGGrid< 2 > Grid;
+
+void compare ( GridPtr< Grid > &a, GridPtr< Grid > &b, const std::string &name )
+{
+  const auto gvA = a->leafGridView();
+  const auto gvB = b->leafGridView();
+  if( (gvA.size( 0 ) != gvB.size( 0 )) || (gvA.size( Grid::dimension ) != gvB.size( Grid::dimension )) )
+    DUNE_THROW( GridError, name << ": Grid sizes differ" );
+  if( (a.nofParameters( 0 ) != b.nofParameters( 0 )) || (a.nofParameters( Grid::dimension ) != b.nofParameters( Grid::dimension )) )
+    DUNE_THROW( GridError, name << ": Number of parameters differs" );
+
+  // both grids are created from the same macro grid in the same order
+  auto element = elements( gvB ).begin();
+  for( const auto &elementA : elements( gvA ) )
+  {
+    const auto &elementB = *element;
+    ++element;
+    if( (elementA.geometry().center() - elementB.geometry().center()).two_norm() > 1e-12 )
+      DUNE_THROW( GridError, name << ": Elements differ" );
+    if( a.parameters( elementA ) != b.parameters( elementB ) )
+      DUNE_THROW( GridError, name << ": Element parameters differ" );
+
+    for( unsigned int i = 0; i < elementA.subEntities( Grid::dimension ); ++i )
+    {
+      if( a.parameters( elementA.subEntity< Grid::dimension >( i ) ) != b.parameters( elementB.subEntity< Grid::dimension >( i ) ) )
+        DUNE_THROW( GridError, name << ": Vertex parameters differ" );
+    }
+
+    auto intersection = intersections( gvB, elementB ).begin();
+    for( const auto &intersectionA : intersections( gvA, elementA ) )
+    {
+      const auto &intersectionB = *intersection;
+      ++intersection;
+      if( intersectionA.boundary() != intersectionB.boundary() )
+        DUNE_THROW( GridError, name << ": Intersections differ" );
+      if( intersectionA.boundary() && (a.parameters( intersectionA ) != b.parameters( intersectionB )) )
+        DUNE_THROW( GridError, name << ": Boundary parameters differ" );
+    }
+  }
+}
+
+int main ( int argc, char **argv )
+try
+{
+  MPIHelper &mpiHelper = MPIHelper::instance( argc, argv );
+
+  // work on a copy, the cache is written next to the DGF file
+  const std::string fileName( "test-dgf-gridptr-cache.dgf" );
+  const std::string cacheFileName = fileName + ".cache";
+  {
+    std::ifstream in( std::string( DUNE_GRID_EXAMPLE_GRIDS_PATH ) + "dgf/unstr_cube.dgf" );
+    if( !in )
+      DUNE_THROW( IOError, "Could not open unstr_cube.dgf" );
+    std::ofstream out( fileName );
+    out << in.rdbuf();
+  }
+  std::remove( cacheFileName.c_str() );
+
+  GridPtr< Grid > reference( fileName, mpiHelper.getCommunicator(), false );
+  if( std::ifstream( cacheFileName ) )
+    DUNE_THROW( GridError, "Cache file was written although the cache is disabled" );
+
+  GridPtr< Grid > writer( fileName, mpiHelper.getCommunicator(), true );
+  compare( reference, writer, "empty cache" );
+  if( (mpiHelper.rank() == 0) && !std::ifstream( cacheFileName ) )
+    DUNE_THROW( GridError, "Cache file was not written" );
+
+  GridPtr< Grid > reader( fileName, mpiHelper.getCommunicator(), true );
+  compare( reference, reader, "cache" );
+
+  std::remove( cacheFileName.c_str() );
+  std::remove( fileName.c_str() );
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch (...)
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 1;
+}
@@ -0,0 +1,201 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/io/file/dgfparser/blocks/projection.hh>
+
+/** \file
+ * \brief Check the compiled DGF projections and measure their speed
+ *
+ * The refinement of a curved boundary is emulated on the boundary of the
+ * square in example-projection.dgf: In each refinement step, every boundary
+ * edge is bisected and its midpoint is projected with the default projection,
+ * as a grid does for new boundary vertices. The projections are compared with
+ * a direct evaluation of the parsed expressions. The projection is also
+ * evaluated from several threads at once. Call e.g.
+ *
+ *   ./test-dgf-projection 20
+ *
+ * to refine the boundary 20 times.
+ */
+
+using namespace Dune;
+
+typedef FieldVector< double, 2 > Coordinate;
+
+// evaluate the expression tree directly
+Coordinate evaluate ( const dgf::ProjectionBlock::Expression &expression, const Coordinate &x )
+{
+  std::vector< double > argument( x.begin(), x.end() ), result;
+  expression.evaluate( argument, result );
+  Coordinate y;
+  for( int i = 0; i < 2; ++i )
+    y[ i ] = result[ i ];
+  return y;
+}
+
+void check ( const Coordinate &a, const Coordinate &b, const std::string &message )
+{
+  if( (a - b).two_norm() > 1e-14 * (1.0 + a.two_norm()) )
+    DUNE_THROW( GridError, message << ": " << a << " != " << b );
+}
+
+// compare the compiled projections with the expressions for all operations
+void checkOperations ()
+{
+  std::istringstream input( "DGF\n"
+                            "PROJECTION\n"
+                            "function f(x) = [ x[0] + sin(x[1]) * 2, cos(pi*x[0])**2 - x[1]/3 ]\n"
+                            "function g(x) = -f(x) * |x| + sqrt(x*x) * [ 1, 2 ] + 0.5 * f([ 1, 2 ])\n"
+                            "function h(x) = x + [ 1, 2, 3 ]\n"
+                            "segment 0 1 h\n"
+                            "default g\n"
+                            "#\n" );
+  dgf::ProjectionBlock block( input, 2 );
+
+  std::unique_ptr< const DuneBoundaryProjection< 2 > > projection( block.defaultProjection< 2 >() );
+  for( int i = 0; i < 10; ++i )
+  {
+    Coordinate x;
+    x[ 0 ] = 0.3 * i - 1.0;
+    x[ 1 ] = 0.1 * i * i;
+    check( (*projection)( x ), evaluate( *block.function( "g" ), x ), "Compiled projection differs from expression" );
+  }
+
+  // expressions that cannot be compiled still report their errors on evaluation
+  std::unique_ptr< const DuneBoundaryProjection< 2 > > invalid( block.boundaryProjection< 2 >( 0 ) );
+  bool thrown = false;
+  try
+  {
+    (*invalid)( Coordinate( 1.0 ) );
+  }
+  catch( const MathError & )
+  {
+    thrown = true;
+  }
+  if( !thrown )
+    DUNE_THROW( GridError, "Sum of vectors of different size did not throw" );
+}
+
+// evaluate one projection from several threads at the same time
+void checkConcurrency ( const std::string &fileName )
+{
+  std::ifstream input( fileName );
+  if( !input )
+    DUNE_THROW( IOError, "Could not open " << fileName );
+  dgf::ProjectionBlock block( input, 2 );
+  std::unique_ptr< const DuneBoundaryProjection< 2 > > projection( block.defaultProjection< 2 >() );
+
+  const int numThreads = 4, numPoints = 100000;
+  std::vector< Coordinate > points( numPoints ), reference( numPoints );
+  for( int i = 0; i < numPoints; ++i )
+  {
+    points[ i ][ 0 ] = std::cos( 0.0001 * i ) * (1.0 + 0.00001 * i);
+    points[ i ][ 1 ] = std::sin( 0.0001 * i );
+    reference[ i ] = (*projection)( points[ i ] );
+  }
+
+  std::vector< std::vector< Coordinate > > projected( numThreads, std::vector< Coordinate >( numPoints ) );
+  std::vector< std::thread > threads;
+  for( int t = 0; t < numThreads; ++t )
+    threads.emplace_back( [ &, t ] () {
+        for( int i = 0; i < numPoints; ++i )
+          projected[ t ][ i ] = (*projection)( points[ i ] );
+      } );
+  for( std::thread &thread : threads )
+    thread.join();
+
+  for( int t = 0; t < numThreads; ++t )
+    for( int i = 0; i < numPoints; ++i )
+      check( projected[ t ][ i ], reference[ i ], "Concurrent projection differs" );
+}
+
+// bisect the boundary edges and project the midpoints
+void benchmark ( const std::string &fileName, int refinements )
+{
+  std::ifstream input( fileName );
+  if( !input )
+    DUNE_THROW( IOError, "Could not open " << fileName );
+  dgf::ProjectionBlock block( input, 2 );
+  std::unique_ptr< const DuneBoundaryProjection< 2 > > projection( block.defaultProjection< 2 >() );
+  const dgf::ProjectionBlock::Expression &expression = *block.function( "p" );
+
+  std::vector< Coordinate > boundary( 4, Coordinate( -1.0 ) );
+  boundary[ 1 ][ 0 ] = boundary[ 2 ][ 0 ] = boundary[ 2 ][ 1 ] = boundary[ 3 ][ 1 ] = 1.0;
+
+  double compiledTime = 0.0, expressionTime = 0.0;
+  Timer watch;
+  for( int level = 0; level < refinements; ++level )
+  {
+    std::vector< Coordinate > midpoints( boundary.size() );
+    for( std::size_t i = 0; i < boundary.size(); ++i )
+    {
+      midpoints[ i ] = boundary[ i ];
+      midpoints[ i ] += boundary[ (i+1) % boundary.size() ];
+      midpoints[ i ] *= 0.5;
+    }
+
+    std::vector< Coordinate > projected( midpoints.size() );
+    watch.reset();
+    for( std::size_t i = 0; i < midpoints.size(); ++i )
+      projected[ i ] = (*projection)( midpoints[ i ] );
+    compiledTime += watch.elapsed();
+
+    std::vector< Coordinate > reference( midpoints.size() );
+    watch.reset();
+    for( std::size_t i = 0; i < midpoints.size(); ++i )
+      reference[ i ] = evaluate( expression, midpoints[ i ] );
+    expressionTime += watch.elapsed();
+
+    std::vector< Coordinate > refined;
+    refined.reserve( 2*boundary.size() );
+    for( std::size_t i = 0; i < boundary.size(); ++i )
+    {
+      check( projected[ i ], reference[ i ], "Compiled projection differs from expression" );
+      if( std::abs( projected[ i ].two_norm() - std::sqrt( 2.0 ) ) > 1e-12 )
+        DUNE_THROW( GridError, "Projected vertex " << projected[ i ] << " does not lie on the circle" );
+      refined.push_back( boundary[ i ] );
+      refined.push_back( projected[ i ] );
+    }
+    boundary.swap( refined );
+  }
+
+  std::cout << "Projecting " << boundary.size() - 4 << " boundary vertices:" << std::endl;
+  std::cout << "  compiled projection: " << compiledTime << " s" << std::endl;
+  std::cout << "  expression tree:     " << expressionTime << " s" << std::endl;
+}
+
+int main ( int argc, char **argv )
+try
+{
+  const int refinements = (argc > 1) ? std::atoi( argv[ 1 ] ) : 16;
+
+  checkOperations();
+  checkConcurrency( std::string( DUNE_GRID_EXAMPLE_GRIDS_PATH ) + "dgf/example-projection.dgf" );
+  benchmark( std::string( DUNE_GRID_EXAMPLE_GRIDS_PATH ) + "dgf/example-projection.dgf", refinements );
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch (...)
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 1;
+}
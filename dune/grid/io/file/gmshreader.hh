@@ -4,16 +4,23 @@
 #ifndef DUNE_GMSHREADER_HH
 #define DUNE_GMSHREADER_HH
 
-#include <cstdarg>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <dune/common/deprecated.hh>
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
 
@@ -198,6 +205,283 @@ namespace Dune
 
   }   // end empty namespace
 
+  namespace Impl {
+
+    /** \brief Buffered reader for Gmsh files
+     *
+     * The file is read in large blocks, and ASCII tokens as well as binary
+     * values are parsed directly from the buffer. This is considerably faster
+     * than one fscanf call per token and allows to read binary files.
+     */
+    class GmshFileBuffer
+    {
+      // numbers are guaranteed to be contiguous in the buffer up to this length
+      static const std::size_t maxTokenLength = 128;
+
+    public:
+      explicit GmshFileBuffer (const std::string& fileName, std::size_t blockSize = 1 << 20)
+        : fileName_(fileName), file_(std::fopen(fileName.c_str(), "rb")),
+          buffer_(blockSize + 1), pos_(0), end_(0), offset_(0), swap_(false)
+      {
+        if (file_ == 0)
+          DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+        buffer_[0] = '\0';
+      }
+
+      GmshFileBuffer (const GmshFileBuffer&) = delete;
+      GmshFileBuffer& operator= (const GmshFileBuffer&) = delete;
+
+      ~GmshFileBuffer ()
+      {
+        std::fclose(file_);
+      }
+
+      //! skip whitespace, returns false at the end of the file
+      bool skipWhitespace ()
+      {
+        while (true)
+        {
+          while (pos_ < end_ && std::isspace(static_cast<unsigned char>(buffer_[pos_])))
+            ++pos_;
+          if (pos_ < end_)
+            return true;
+          if (!fill(1))
+            return false;
+        }
+      }
+
+      //! skip over the rest of the line, including the terminating newline
+      void skipLine ()
+      {
+        while (true)
+        {
+          while (pos_ < end_ && buffer_[pos_] != '\n')
+            ++pos_;
+          if (pos_ < end_)
+          {
+            ++pos_;
+            return;
+          }
+          if (!fill(1))
+            return;
+        }
+      }
+
+      /** \brief skip the lines up to and including the line that starts with the given end marker
+       *
+       * The section is skipped line by line, so that the content of binary sections
+       * cannot be mistaken for the end marker unless it follows a line break.
+       */
+      void skipSection (const std::string& end)
+      {
+        skipLine();
+        while (true)
+        {
+          if (!fill(end.size()))
+            error("unexpected end of file, expected " + end);
+          if (std::memcmp(buffer_.data() + pos_, end.data(), end.size()) == 0)
+          {
+            skipLine();
+            return;
+          }
+          skipLine();
+        }
+      }
+
+      //! return the next character without consuming it, call only if skipWhitespace() returned true
+      char peek () const
+      {
+        return buffer_[pos_];
+      }
+
+      //! read the next whitespace-delimited word
+      std::string word ()
+      {
+        if (!skipWhitespace())
+          error("unexpected end of file");
+        std::string w;
+        while (true)
+        {
+          const std::size_t start = pos_;
+          while (pos_ < end_ && !std::isspace(static_cast<unsigned char>(buffer_[pos_])))
+            ++pos_;
+          w.append(buffer_.data() + start, pos_ - start);
+          if (pos_ < end_ || !fill(1))
+            return w;
+        }
+      }
+
+      //! read the next word and throw if it differs from the expected one
+      void expect (const std::string& expected)
+      {
+        if (word() != expected)
+          error("expected " + expected);
+      }
+
+      //! read an ASCII integer
+      long long integer ()
+      {
+        if (!skipWhitespace())
+          error("unexpected end of file, expected an integer");
+        fill(maxTokenLength);
+
+        const char* p = buffer_.data() + pos_;
+        const bool negative = (*p == '-');
+        if (*p == '-' || *p == '+')
+          ++p;
+        if (!std::isdigit(static_cast<unsigned char>(*p)))
+          error("expected an integer");
+
+        long long value = 0;
+        while (std::isdigit(static_cast<unsigned char>(*p)))
+          value = 10*value + (*p++ - '0');
+        pos_ = p - buffer_.data();
+        return negative ? -value : value;
+      }
+
+      //! read an ASCII floating point number
+      double real ()
+      {
+        if (!skipWhitespace())
+          error("unexpected end of file, expected a number");
+        fill(maxTokenLength);
+
+        const char* p = buffer_.data() + pos_;
+        char* q;
+        const double value = std::strtod(p, &q);
+        if (q == p)
+          error("expected a number");
+        pos_ = q - buffer_.data();
+        return value;
+      }
+
+      //! swap the byte order of all following binary values
+      void setSwapBytes (bool swap)
+      {
+        swap_ = swap;
+      }
+
+      //! read raw bytes
+      void binary (void* target, std::size_t size)
+      {
+        char* t = static_cast<char*>(target);
+        while (size > 0)
+        {
+          if (!fill(1))
+            error("unexpected end of file in binary data");
+          const std::size_t n = std::min(size, end_ - pos_);
+          std::memcpy(t, buffer_.data() + pos_, n);
+          pos_ += n;
+          t += n;
+          size -= n;
+        }
+      }
+
+      //! read count binary values of type T
+      template<class T>
+      void binary (T* target, std::size_t count)
+      {
+        binary(static_cast<void*>(target), count*sizeof(T));
+        if (swap_)
+          for (std::size_t i = 0; i < count; ++i)
+            swapBytes(target[i]);
+      }
+
+      //! read one binary value of type T
+      template<class T>
+      T binary ()
+      {
+        T value;
+        binary(&value, 1);
+        return value;
+      }
+
+      //! read a binary unsigned integer of the given width in bytes (4 or 8)
+      std::uint64_t binaryUnsigned (int width)
+      {
+        if (width == 4)
+          return binary<std::uint32_t>();
+        if (width == 8)
+          return binary<std::uint64_t>();
+        error("unsupported integer size " + std::to_string(width));
+        return 0;
+      }
+
+      //! skip the given number of bytes
+      void skip (std::size_t size)
+      {
+        if (end_ - pos_ >= size)
+          pos_ += size;
+        else
+          seek(position() + size);
+      }
+
+      //! return the current position in the file
+      std::size_t position () const
+      {
+        return offset_ + pos_;
+      }
+
+      //! continue reading at the given position in the file
+      void seek (std::size_t position)
+      {
+        if (fseeko(file_, position, SEEK_SET) != 0)
+          error("could not seek to file position " + std::to_string(position));
+        offset_ = position;
+        pos_ = 0;
+        end_ = 0;
+        buffer_[0] = '\0';
+      }
+
+      //! throw an IOError with the current file position
+      void error (const std::string& message) const
+      {
+        DUNE_THROW(Dune::IOError, "Error parsing " << fileName_ << " at file position "
+                   << position() << ": " << message);
+      }
+
+    private:
+      // make sure that at least need bytes are in the buffer, unless the file ends before
+      bool fill (std::size_t need)
+      {
+        if (end_ - pos_ >= need)
+          return true;
+
+        // move the unread rest to the front of the buffer and read the next block
+        std::memmove(buffer_.data(), buffer_.data() + pos_, end_ - pos_);
+        offset_ += pos_;
+        end_ -= pos_;
+        pos_ = 0;
+        while (end_ < need)
+        {
+          const std::size_t n = std::fread(buffer_.data() + end_, 1, buffer_.size() - 1 - end_, file_);
+          if (n == 0)
+            break;
+          end_ += n;
+        }
+        // terminate the data, so that strtod and friends stop at the end of the buffer
+        buffer_[end_] = '\0';
+        return end_ - pos_ >= need;
+      }
+
+      template<class T>
+      static void swapBytes (T& value)
+      {
+        char* bytes = reinterpret_cast<char*>(&value);
+        std::reverse(bytes, bytes + sizeof(T));
+      }
+
+      std::string fileName_;
+      FILE* file_;
+      std::vector<char> buffer_;
+      std::size_t pos_;
+      std::size_t end_;
+      std::size_t offset_;
+      bool swap_;
+    };
+
+  } // end namespace Impl
+
   //! dimension independent parts for GmshReaderParser
   template<typename GridType>
   class GmshReaderParser
@@ -210,12 +494,27 @@ namespace Dune
     unsigned int number_of_real_vertices;
     int boundary_element_count;
     int element_count;
-    // read buffer
-    char buf[512];
     std::string fileName;
+    // file format
+    double version_number;
+    bool binary;
+    int data_size;
     // exported data
     std::vector<int> boundary_id_to_physical_entity;
     std::vector<int> element_index_to_physical_entity;
+    // physical entity of the geometrical entities of each dimension (MSH 4 only)
+    std::array<std::map<int,int>, 4> entity_to_physical_entity;
+    // position of each node in the node vector, if the node tags are too sparse to be used directly
+    bool sparse_node_tags;
+    std::unordered_map<long long,int> node_tag_to_index;
+    // the slice of the grid elements that is read, and the corresponding range in the $Elements section
+    int slice;
+    int number_of_slices;
+    long long slice_begin;
+    long long slice_end;
+    // if select_nodes is set, only the nodes with tags in the sorted vector selected_nodes are stored
+    bool select_nodes;
+    std::vector<int> selected_nodes;
 
     // static data
     static const int dim = GridType::dimension;
@@ -225,36 +524,139 @@ namespace Dune
     // typedefs
     typedef FieldVector< double, dimWorld > GlobalVector;
 
-    // don't use something like
-    //   readfile(file, 1, "%s\n", buf);
-    // to skip the rest of of the line -- that will only skip the next
-    // whitespace-separated word!  Use skipline() instead.
-    void readfile(FILE * file, int cnt, const char * format,
-                  void* t1, void* t2 = 0, void* t3 = 0, void* t4 = 0,
-                  void* t5 = 0, void* t6 = 0, void* t7 = 0, void* t8 = 0,
-                  void* t9 = 0, void* t10 = 0)
+    /** \brief The elements of a file that are relevant for the grid
+     *
+     * The element section is parsed only once and stored here, both passes
+     * then work on this data.
+     */
+    struct ElementList
+    {
+      std::vector<int> type;             // Gmsh element type
+      std::vector<int> physical_entity;  // physical entity, -1 if none given
+      std::vector<int> offset;           // start of the nodes of each element in nodes
+      std::vector<int> nodes;            // Gmsh node numbers of all elements
+
+      void push_back (int elm_type, int physical, const int* elementNodes, int count)
+      {
+        type.push_back(elm_type);
+        physical_entity.push_back(physical);
+        offset.push_back(nodes.size());
+        nodes.insert(nodes.end(), elementNodes, elementNodes + count);
+      }
+
+      std::size_t size () const
+      {
+        return type.size();
+      }
+    };
+
+    //! number of nodes of a Gmsh element type, -1 if the type is unknown
+    static int numberOfNodes (int elm_type)
+    {
+      static const int nNodes[32] = {-1, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1,
+                                     8, 20, 15, 13, 9, 10, 12, 15, 15, 21, 4, 5, 6, 20, 35, 56};
+      return (elm_type > 0 && elm_type < 32) ? nNodes[elm_type] : -1;
+    }
+
+    //! dimension of the elements of a supported Gmsh element type, -1 otherwise
+    static int elementDimension (int elm_type)
+    {
+      const int elementDim[12] = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, -1, 3};
+      return (elm_type >= 0 && elm_type < 12) ? elementDim[elm_type] : -1;
+    }
+
+    //! return true if elements of this type are read, either as elements or as boundary segments
+    static bool isSupported (int elm_type)
+    {
+      const int d = elementDimension(elm_type);
+      return d >= 0 && (d == dim || d == (dim-1));    // real element or boundary element?
+    }
+
+    //! return true if elements of this type are elements of the grid, and not boundary segments
+    static bool isGridElement (int elm_type)
+    {
+      return elementDimension(elm_type) == dim;
+    }
+
+    //! set the range of grid elements that belong to the slice
+    void setSliceRange (long long number_of_grid_elements)
+    {
+      slice_begin = number_of_grid_elements * slice / number_of_slices;
+      slice_end = number_of_grid_elements * (slice+1) / number_of_slices;
+    }
+
+    /** \brief The part [first, last) of a block of elements that is read
+     *
+     * \param g number of grid elements before the block
+     */
+    void blockRange (int elm_type, long long g, long long count, long long& first, long long& last) const
+    {
+      first = 0;
+      last = isSupported(elm_type) ? count : 0;
+      // all slices read the boundary segments, the grid elements are split
+      if (isGridElement(elm_type))
+      {
+        first = std::min(std::max(slice_begin - g, 0LL), count);
+        last = std::min(std::max(slice_end - g, 0LL), count);
+      }
+    }
+
+    /** \brief store a node
+     *
+     * Usually, the node tag is the position in the node vector, which grows if
+     * necessary. For sparse node tags the nodes are stored consecutively and
+     * the position of each tag is kept in a hash map.
+     */
+    void storeNode (std::vector< GlobalVector > & nodes, long long id, const double* x)
     {
-      off_t pos = ftello(file);
-      int c = fscanf(file, format, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10);
-      if (c != cnt)
-        DUNE_THROW(Dune::IOError, "Error parsing " << fileName << " "
-                   "file pos " << pos
-                                                   << ": Expected '" << format << "', only read " << c << " entries instead of " << cnt << ".");
+      if (id < 0 || id > std::numeric_limits<int>::max())
+        DUNE_THROW(Dune::IOError, "Invalid node index " << id << ".");
+      if (select_nodes && !std::binary_search(selected_nodes.begin(), selected_nodes.end(), id))
+        return;
+      std::size_t index = id;
+      if (sparse_node_tags)
+      {
+        index = nodes.size();
+        if (!node_tag_to_index.emplace(id, index).second)
+          DUNE_THROW(Dune::IOError, "Node index " << id << " is not unique.");
+        nodes.emplace_back();
+      }
+      else if (index >= nodes.size())
+        nodes.resize(index+1);
+      for( int j = 0; j < dimWorld; ++j )
+        nodes[ index ][ j ] = x[ j ];
     }
 
-    // skip over the rest of the line, including the terminating newline
-    void skipline(FILE * file)
+    //! return the position of the node with the given tag in the node vector
+    int nodeIndex (long long id) const
     {
-      int c;
-      do {
-        c = std::fgetc(file);
-      } while(c != '\n' && c != EOF);
+      if (sparse_node_tags)
+      {
+        const auto it = node_tag_to_index.find(id);
+        if (it == node_tag_to_index.end())
+          DUNE_THROW(Dune::IOError, "Element refers to unknown node " << id << ".");
+        return it->second;
+      }
+      if (id < 0 || id > std::numeric_limits<int>::max())
+        DUNE_THROW(Dune::IOError, "Invalid node index " << id << ".");
+      return id;
+    }
+
+    //! translate a node tag of an element, unless the nodes are read after the elements
+    int elementNode (long long id) const
+    {
+      if (number_of_slices == 1)
+        return nodeIndex(id);
+      if (id < 0 || id > std::numeric_limits<int>::max())
+        DUNE_THROW(Dune::IOError, "Invalid node index " << id << ".");
+      return id;
     }
 
   public:
 
     GmshReaderParser(Dune::GridFactory<GridType>& _factory, bool v, bool i) :
-      factory(_factory), verbose(v), insert_boundary_segments(i) {}
+      factory(_factory), verbose(v), insert_boundary_segments(i),
+      slice(0), number_of_slices(1), select_nodes(false) {}
 
     std::vector<int> & boundaryIdMap()
     {
@@ -266,113 +668,124 @@ namespace Dune
       return element_index_to_physical_entity;
     }
 
-    void read (const std::string& f)
+    /** \brief Read a Gmsh file
+     *
+     * Supported are the MSH versions 2.0 to 2.2 and 4.0 to 4.1, each in ASCII
+     * and binary encoding.
+     *
+     * The grid elements can be split into numberOfSlices contiguous chunks in
+     * the order of the file, and only chunk sliceIndex is read. Only the nodes
+     * used by these elements are stored, and the boundary segments whose
+     * vertices all belong to them. In binary files, the elements of other
+     * slices are skipped without parsing them.
+     */
+    void read (const std::string& f, int sliceIndex = 0, int numberOfSlices = 1)
     {
       if (verbose) std::cout << "Reading " << dim << "d Gmsh grid..." << std::endl;
 
-      // open file name, we use C I/O
-      fileName = f;
-      FILE* file = fopen(fileName.c_str(),"r");
-      if (file==0)
-        DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+      if (numberOfSlices < 1 || sliceIndex < 0 || sliceIndex >= numberOfSlices)
+        DUNE_THROW(Dune::RangeError, "Invalid slice " << sliceIndex << " of " << numberOfSlices);
+      slice = sliceIndex;
+      number_of_slices = numberOfSlices;
+      select_nodes = false;
+      selected_nodes.clear();
 
-      //=========================================
-      // Header: Read vertices into vector
-      //         Check vertices that are needed
-      //=========================================
+      fileName = f;
+      Impl::GmshFileBuffer file(fileName);
 
       number_of_real_vertices = 0;
       boundary_element_count = 0;
       element_count = 0;
+      sparse_node_tags = false;
+      node_tag_to_index.clear();
 
-      // process header
-      double version_number;
-      int file_type, data_size;
+      readHeader(file);
 
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$MeshFormat")!=0)
-        DUNE_THROW(Dune::IOError, "expected $MeshFormat in first line");
-      readfile(file,3,"%lg %d %d\n",&version_number,&file_type,&data_size);
-      if( (version_number < 2.0) || (version_number > 2.2) )
-        DUNE_THROW(Dune::IOError, "can only read Gmsh version 2 files");
-      if (verbose) std::cout << "version " << version_number << " Gmsh file detected" << std::endl;
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$EndMeshFormat")!=0)
-        DUNE_THROW(Dune::IOError, "expected $EndMeshFormat");
-
-      // node section
-      int number_of_nodes;
-
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$Nodes")!=0)
-        DUNE_THROW(Dune::IOError, "expected $Nodes");
-      readfile(file,1,"%d\n",&number_of_nodes);
-      if (verbose) std::cout << "file contains " << number_of_nodes << " nodes" << std::endl;
+      //=========================================
+      // Read all sections: nodes into a vector,
+      // relevant elements into an ElementList
+      //=========================================
 
-      // read nodes
-      // The '+1' is due to the fact that gmsh numbers node starting from 1 rather than from 0
-      std::vector< GlobalVector > nodes( number_of_nodes+1 );
+      std::vector< GlobalVector > nodes;
+      ElementList elements;
+      bool haveNodes = false, haveElements = false;
+      std::size_t nodes_position = 0;
+
+      while (file.skipWhitespace())
       {
-        int id;
-        double x[ 3 ];
-        for( int i = 1; i <= number_of_nodes; ++i )
+        const std::string section = file.word();
+        if (section == "$Nodes")
         {
-          readfile(file,4, "%d %lg %lg %lg\n", &id, &x[ 0 ], &x[ 1 ], &x[ 2 ] );
-
-          if (id > number_of_nodes) {
-            DUNE_THROW(Dune::IOError,
-                       "Only dense sequences of node indices are currently supported (node index "
-                       << id << " is invalid).");
+          if (number_of_slices > 1)
+          {
+            // read the nodes once we know which of them are needed
+            nodes_position = file.position();
+            skipNodes(file);
           }
-
-          // just store node position
-          for( int j = 0; j < dimWorld; ++j )
-            nodes[ id ][ j ] = x[ j ];
+          else if (version_number < 4.0)
+            readNodes2(file, nodes);
+          else
+            readNodes4(file, nodes);
+          file.expect("$EndNodes");
+          haveNodes = true;
         }
-        readfile(file,1,"%s\n",buf);
-        if (strcmp(buf,"$EndNodes")!=0)
-          DUNE_THROW(Dune::IOError, "expected $EndNodes");
+        else if (section == "$Elements")
+        {
+          if (version_number < 4.0)
+            readElements2(file, elements);
+          else
+            readElements4(file, elements);
+          file.expect("$EndElements");
+          haveElements = true;
+        }
+        else if (section == "$Entities" && version_number >= 4.0)
+        {
+          readEntities(file);
+          file.expect("$EndEntities");
+        }
+        else if (section.size() > 1 && section[0] == '$')
+        {
+          // skip sections we don't need, e.g. $PhysicalNames or $NodeData
+          file.skipSection("$End" + section.substr(1));
+        }
+        else
+          file.error("expected a section, found " + section);
       }
 
-      // element section
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$Elements")!=0)
-        DUNE_THROW(Dune::IOError, "expected $Elements");
-      int number_of_elements;
-      readfile(file,1,"%d\n",&number_of_elements);
-      if (verbose) std::cout << "file contains " << number_of_elements << " elements" << std::endl;
+      if (!haveNodes)
+        DUNE_THROW(Dune::IOError, "expected $Nodes in " << fileName);
+      if (!haveElements)
+        DUNE_THROW(Dune::IOError, "expected $Elements in " << fileName);
+
+      if (number_of_slices > 1)
+      {
+        selectNodes(elements);
+        file.seek(nodes_position);
+        if (version_number < 4.0)
+          readNodes2(file, nodes);
+        else
+          readNodes4(file, nodes);
+        file.expect("$EndNodes");
+
+        // the elements still refer to the node tags
+        for (int& n : elements.nodes)
+          n = nodeIndex(n);
+      }
 
       //=========================================
       // Pass 1: Select and insert those vertices in the file that
       //    actually occur as corners of an element.
       //=========================================
 
-      long section_element_offset = ftell(file);
-      std::map<int,unsigned int> renumber;
-      for (int i=1; i<=number_of_elements; i++)
-      {
-        int id, elm_type, number_of_tags;
-        readfile(file,3,"%d %d %d ",&id,&elm_type,&number_of_tags);
-        for (int k=1; k<=number_of_tags; k++)
-        {
-          int blub;
-          readfile(file,1,"%d ",&blub);
-          // k == 1: physical entity (not used here)
-          // k == 2: elementary entity (not used here either)
-          // if version_number < 2.2:
-          //   k == 3: mesh partition 0
-          // else
-          //   k == 3: number of mesh partitions
-          //   k => 4: mesh partition k-4
-        }
-        pass1HandleElement(file, elm_type, renumber, nodes);
-      }
+      // the vertex index of each node, or 'unused' if it is not a vertex of any element
+      const unsigned int unused = std::numeric_limits<unsigned int>::max();
+      std::vector<unsigned int> renumber(nodes.size(), unused);
+      for (std::size_t i=0; i<elements.size(); i++)
+        pass1HandleElement(elements.type[i], &elements.nodes[elements.offset[i]], renumber, nodes);
+
       if (verbose) std::cout << "number of real vertices = " << number_of_real_vertices << std::endl;
       if (verbose) std::cout << "number of boundary elements = " << boundary_element_count << std::endl;
       if (verbose) std::cout << "number of elements = " << element_count << std::endl;
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$EndElements")!=0)
-        DUNE_THROW(Dune::IOError, "expected $EndElements");
       boundary_id_to_physical_entity.resize(boundary_element_count);
       element_index_to_physical_entity.resize(element_count);
 
@@ -380,28 +793,552 @@ namespace Dune
       // Pass 2: Insert boundary segments and elements
       //==============================================
 
-      fseek(file, section_element_offset, SEEK_SET);
       boundary_element_count = 0;
       element_count = 0;
-      for (int i=1; i<=number_of_elements; i++)
+      for (std::size_t i=0; i<elements.size(); i++)
+        pass2HandleElement(elements.type[i], &elements.nodes[elements.offset[i]], renumber, nodes,
+                           elements.physical_entity[i]);
+    }
+
+  protected:
+
+    //! read the $MeshFormat section and set up the file for binary reading if necessary
+    void readHeader (Impl::GmshFileBuffer& file)
+    {
+      if (file.word() != "$MeshFormat")
+        DUNE_THROW(Dune::IOError, "expected $MeshFormat in first line");
+      version_number = file.real();
+      const int file_type = file.integer();
+      data_size = file.integer();
+      if( (version_number < 2.0) || (version_number > 2.2 && version_number < 4.0) || (version_number > 4.1) )
+        DUNE_THROW(Dune::IOError, "can only read Gmsh version 2 and 4 files");
+      binary = (file_type == 1);
+      if (verbose) std::cout << "version " << version_number << (binary ? " binary" : "")
+                             << " Gmsh file detected" << std::endl;
+
+      if (binary)
       {
-        int id, elm_type, number_of_tags;
-        readfile(file,3,"%d %d %d ",&id,&elm_type,&number_of_tags);
-        int physical_entity = -1;
+        // the header contains the integer one in the byte order of the writing machine
+        file.skipLine();
+        const int one = file.binary<int>();
+        if (one != 1)
+        {
+          file.setSwapBytes(true);
+          int swapped = one;
+          char* bytes = reinterpret_cast<char*>(&swapped);
+          std::reverse(bytes, bytes + sizeof(int));
+          if (swapped != 1)
+            DUNE_THROW(Dune::IOError, "invalid byte order mark in binary Gmsh file");
+        }
+      }
+      file.expect("$EndMeshFormat");
+    }
+
+    //! read the $Nodes section of a MSH 2 file
+    void readNodes2 (Impl::GmshFileBuffer& file, std::vector< GlobalVector > & nodes)
+    {
+      const long long number_of_nodes = file.integer();
+      if (verbose) std::cout << "file contains " << number_of_nodes << " nodes" << std::endl;
+
+      // The '+1' is due to the fact that gmsh numbers node starting from 1 rather than from 0
+      if (!sparse_node_tags)
+        nodes.resize( number_of_nodes+1 );
+      double x[ 3 ];
+      if (binary)
+        file.skipLine();
+      for( long long i = 1; i <= number_of_nodes; ++i )
+      {
+        long long id;
+        if (binary)
+        {
+          id = file.binary<int>();
+          file.binary(x, 3);
+        }
+        else
+        {
+          id = file.integer();
+          for (int j = 0; j < 3; ++j)
+            x[ j ] = file.real();
+        }
+
+        if (id > number_of_nodes) {
+          DUNE_THROW(Dune::IOError,
+                     "Only dense sequences of node indices are currently supported (node index "
+                     << id << " is invalid).");
+        }
+
+        // just store node position
+        storeNode(nodes, id, x);
+      }
+    }
+
+    //! read the $Elements section of a MSH 2 file
+    void readElements2 (Impl::GmshFileBuffer& file, ElementList& elements)
+    {
+      const long long number_of_elements = file.integer();
+      if (verbose) std::cout << "file contains " << number_of_elements << " elements" << std::endl;
+      if (binary)
+        file.skipLine();
+      setSliceRange(number_of_slices > 1 ? countGridElements2(file, number_of_elements) : number_of_elements);
+
+      std::vector<int> dofs;
+      long long g = 0;    // number of grid elements before the current one
+
+      if (binary)
+      {
+        // the elements come in blocks of equal type and number of tags
+        for (long long i = 0; i < number_of_elements; )
+        {
+          int header[3];
+          file.binary(header, 3);
+          const int elm_type = header[0], count = header[1], number_of_tags = header[2];
+          const int nNodes = numberOfNodes(elm_type);
+          if (nNodes < 0)
+            file.error("unknown element type " + std::to_string(elm_type));
+
+          // id, tags and nodes of one element
+          dofs.resize(1 + number_of_tags + nNodes);
+          const std::size_t recordSize = dofs.size() * sizeof(int);
+
+          long long first, last;
+          blockRange(elm_type, g, count, first, last);
+          file.skip(first * recordSize);
+          for (long long k = first; k < last; ++k)
+          {
+            file.binary(dofs.data(), dofs.size());
+            // k == 1: physical entity
+            const int physical_entity = (number_of_tags > 0) ? dofs[1] : -1;
+            elements.push_back(elm_type, physical_entity, &dofs[1+number_of_tags], nNodes);
+          }
+          file.skip((count - last) * recordSize);
+          i += count;
+          if (isGridElement(elm_type))
+            g += count;
+        }
+      }
+      else
+      {
+        for (long long i = 0; i < number_of_elements; i++)
+        {
+          file.integer();      // id
+          const int elm_type = file.integer();
+          const int number_of_tags = file.integer();
+          int physical_entity = -1;
+          for (int k = 1; k <= number_of_tags; k++)
+          {
+            const int blub = file.integer();
+            // k == 1: physical entity
+            // k == 2: elementary entity (not used here)
+            // if version_number < 2.2:
+            //   k == 3: mesh partition 0
+            // else
+            //   k == 3: number of mesh partitions
+            //   k => 4: mesh partition k-4
+            if (k == 1) physical_entity = blub;
+          }
+
+          // test whether we support the element type, and whether it belongs to the slice
+          long long first, last;
+          blockRange(elm_type, g, 1, first, last);
+          if (isGridElement(elm_type))
+            ++g;
+          if (first == last)
+          {
+            file.skipLine();      // skip rest of line if element is unknown
+            continue;
+          }
+
+          const int nNodes = numberOfNodes(elm_type);
+          dofs.resize(nNodes);
+          for (int k = 0; k < nNodes; ++k)
+            dofs[k] = file.integer();
+          elements.push_back(elm_type, physical_entity, dofs.data(), nNodes);
+        }
+      }
+    }
+
+    //! read the $Entities section of a MSH 4 file, to find the physical entities of the elements
+    void readEntities (Impl::GmshFileBuffer& file)
+    {
+      // read a size_t in MSH 4.1, an unsigned long in MSH 4.0
+      auto readSize = [&] () -> long long {
+        if (!binary)
+          return file.integer();
+        return file.binaryUnsigned(version_number >= 4.1 ? data_size : 8);
+      };
+      auto readInt = [&] () -> int {
+        return binary ? file.binary<int>() : int(file.integer());
+      };
+      auto readReal = [&] () -> double {
+        return binary ? file.binary<double>() : file.real();
+      };
+
+      if (binary)
+        file.skipLine();
+
+      long long count[4];
+      for (int d = 0; d < 4; ++d)
+        count[d] = readSize();
+
+      for (int d = 0; d < 4; ++d)
+        for (long long i = 0; i < count[d]; ++i)
+        {
+          const int tag = readInt();
+          // points have only coordinates in MSH 4.1, everything else has a bounding box
+          const int nCoords = (d == 0 && version_number >= 4.1) ? 3 : 6;
+          for (int k = 0; k < nCoords; ++k)
+            readReal();
+
+          const long long number_of_physicals = readSize();
+          int physical_entity = 0;
+          for (long long k = 0; k < number_of_physicals; ++k)
+          {
+            const int p = readInt();
+            if (k == 0) physical_entity = p;
+          }
+          entity_to_physical_entity[d][tag] = physical_entity;
+
+          // bounding entities
+          if (d > 0)
+          {
+            const long long number_of_bounding = readSize();
+            for (long long k = 0; k < number_of_bounding; ++k)
+              readInt();
+          }
+        }
+    }
+
+    //! read the $Nodes section of a MSH 4 file
+    void readNodes4 (Impl::GmshFileBuffer& file, std::vector< GlobalVector > & nodes)
+    {
+      const bool v41 = (version_number >= 4.1);
+      const int sizeWidth = v41 ? data_size : 8;
+      auto readSize = [&] () -> long long {
+        return binary ? file.binaryUnsigned(sizeWidth) : file.integer();
+      };
+      auto readInt = [&] () -> int {
+        return binary ? file.binary<int>() : int(file.integer());
+      };
+
+      if (binary)
+        file.skipLine();
+
+      const long long number_of_blocks = readSize();
+      const long long number_of_nodes = readSize();
+      if (verbose) std::cout << "file contains " << number_of_nodes << " nodes" << std::endl;
+      if (v41)
+      {
+        readSize();   // minimum node tag
+        const long long max_tag = readSize();
+        // use the node tags as positions in the node vector, unless this would waste too much memory
+        if (!select_nodes)
+          sparse_node_tags = (max_tag > 2*number_of_nodes + 1);
+        if (select_nodes)
+          nodes.reserve(selected_nodes.size());
+        else if (sparse_node_tags)
+        {
+          nodes.reserve(number_of_nodes);
+          node_tag_to_index.reserve(number_of_nodes);
+        }
+        else
+          nodes.resize(max_tag+1);
+      }
+      else
+        nodes.reserve(number_of_nodes+1);
+
+      std::vector<long long> ids;
+      double x[ 6 ];
+      for (long long b = 0; b < number_of_blocks; ++b)
+      {
+        // entity tag and dimension come in different order in 4.0 and 4.1
+        const int first = readInt();
+        const int second = readInt();
+        const int entityDim = v41 ? first : second;
+        const int parametric = readInt();
+        const long long count = readSize();
+        // parametric nodes have entityDim parametric coordinates after the position
+        const int nCoords = 3 + (parametric ? entityDim : 0);
+
+        if (v41)
+        {
+          // first all tags of the block, then all coordinates
+          ids.resize(count);
+          for (long long k = 0; k < count; ++k)
+            ids[k] = readSize();
+          for (long long k = 0; k < count; ++k)
+          {
+            if (binary)
+              file.binary(x, nCoords);
+            else
+              for (int j = 0; j < nCoords; ++j)
+                x[ j ] = file.real();
+            storeNode(nodes, ids[k], x);
+          }
+        }
+        else
+        {
+          for (long long k = 0; k < count; ++k)
+          {
+            const long long id = readInt();
+            if (binary)
+              file.binary(x, nCoords);
+            else
+              for (int j = 0; j < nCoords; ++j)
+                x[ j ] = file.real();
+            storeNode(nodes, id, x);
+          }
+        }
+      }
+    }
+
+    //! read the $Elements section of a MSH 4 file
+    void readElements4 (Impl::GmshFileBuffer& file, ElementList& elements)
+    {
+      const bool v41 = (version_number >= 4.1);
+      const int sizeWidth = v41 ? data_size : 8;
+      auto readSize = [&] () -> long long {
+        return binary ? file.binaryUnsigned(sizeWidth) : file.integer();
+      };
+      auto readInt = [&] () -> int {
+        return binary ? file.binary<int>() : int(file.integer());
+      };
+      // element and node tags are size_t in 4.1 and int in 4.0
+      auto readTag = [&] () -> long long {
+        return v41 ? readSize() : readInt();
+      };
+
+      if (binary)
+        file.skipLine();
+
+      const long long number_of_blocks = readSize();
+      const long long number_of_elements = readSize();
+      if (verbose) std::cout << "file contains " << number_of_elements << " elements" << std::endl;
+      if (v41)
+      {
+        readSize();   // minimum element tag
+        readSize();   // maximum element tag
+      }
+      setSliceRange(number_of_slices > 1 ? countGridElements4(file, number_of_blocks) : number_of_elements);
+
+      std::vector<int> dofs;
+      long long g = 0;    // number of grid elements before the current block
+      for (long long b = 0; b < number_of_blocks; ++b)
+      {
+        // entity tag and dimension come in different order in 4.0 and 4.1
+        const int first = readInt();
+        const int second = readInt();
+        const int entityDim = v41 ? first : second;
+        const int entityTag = v41 ? second : first;
+        const int elm_type = readInt();
+        const long long count = readSize();
+
+        const int nNodes = numberOfNodes(elm_type);
+        if (nNodes < 0)
+          file.error("unknown element type " + std::to_string(elm_type));
+
+        // the physical entity is the first physical tag of the geometrical entity
+        int physical_entity = 0;
+        if (entityDim >= 0 && entityDim < 4)
+        {
+          const auto it = entity_to_physical_entity[entityDim].find(entityTag);
+          if (it != entity_to_physical_entity[entityDim].end())
+            physical_entity = it->second;
+        }
+
+        // skip elements of unsupported types and of other slices, one line per element in ASCII files
+        const std::size_t recordSize = (1 + nNodes) * (v41 ? sizeWidth : sizeof(int));
+        auto skipElements = [&] (long long n) {
+          if (binary)
+            file.skip(n * recordSize);
+          else
+            for (long long k = 0; k < n; ++k)
+            {
+              file.skipWhitespace();
+              file.skipLine();
+            }
+        };
+
+        long long begin, end;
+        blockRange(elm_type, g, count, begin, end);
+        skipElements(begin);
+        dofs.resize(nNodes);
+        for (long long k = begin; k < end; ++k)
+        {
+          readTag();   // element tag
+          for (int j = 0; j < nNodes; ++j)
+            dofs[j] = elementNode(readTag());
+          elements.push_back(elm_type, physical_entity, dofs.data(), nNodes);
+        }
+        skipElements(count - end);
+        if (isGridElement(elm_type))
+          g += count;
+      }
+    }
+
+    //! count the grid elements in the $Elements section of a MSH 2 file, without moving in the file
+    long long countGridElements2 (Impl::GmshFileBuffer& file, long long number_of_elements)
+    {
+      const std::size_t start = file.position();
+      long long g = 0;
+      for (long long i = 0; i < number_of_elements; )
+      {
+        if (binary)
+        {
+          int header[3];
+          file.binary(header, 3);
+          const int nNodes = numberOfNodes(header[0]);
+          if (nNodes < 0)
+            file.error("unknown element type " + std::to_string(header[0]));
+          file.skip(header[1] * (1 + header[2] + nNodes) * sizeof(int));
+          if (isGridElement(header[0]))
+            g += header[1];
+          i += header[1];
+        }
+        else
+        {
+          file.integer();      // id
+          if (isGridElement(file.integer()))
+            ++g;
+          file.skipLine();
+          ++i;
+        }
+      }
+      file.seek(start);
+      return g;
+    }
+
+    //! count the grid elements in the $Elements section of a MSH 4 file, without moving in the file
+    long long countGridElements4 (Impl::GmshFileBuffer& file, long long number_of_blocks)
+    {
+      const bool v41 = (version_number >= 4.1);
+      const int sizeWidth = v41 ? data_size : 8;
+      const std::size_t start = file.position();
+      long long g = 0;
+      for (long long b = 0; b < number_of_blocks; ++b)
+      {
+        int header[3];
+        long long count;
+        if (binary)
+        {
+          file.binary(header, 3);
+          count = file.binaryUnsigned(sizeWidth);
+        }
+        else
+        {
+          for (int k = 0; k < 3; ++k)
+            header[k] = file.integer();
+          count = file.integer();
+        }
+        const int elm_type = header[2];
+        const int nNodes = numberOfNodes(elm_type);
+        if (nNodes < 0)
+          file.error("unknown element type " + std::to_string(elm_type));
+        if (isGridElement(elm_type))
+          g += count;
+
+        if (binary)
+          file.skip(count * (1 + nNodes) * (v41 ? sizeWidth : sizeof(int)));
+        else
+          for (long long k = 0; k < count; ++k)
+          {
+            file.skipWhitespace();
+            file.skipLine();
+          }
+      }
+      file.seek(start);
+      return g;
+    }
+
+    //! skip over the content of the $Nodes section
+    void skipNodes (Impl::GmshFileBuffer& file)
+    {
+      if (!binary)
+      {
+        // no line of node data starts with '$'
+        while (file.skipWhitespace() && file.peek() != '$')
+          file.skipLine();
+        return;
+      }
+
+      if (version_number < 4.0)
+      {
+        const long long number_of_nodes = file.integer();
+        file.skipLine();
+        file.skip(number_of_nodes * (sizeof(int) + 3*sizeof(double)));
+        return;
+      }
+
+      const bool v41 = (version_number >= 4.1);
+      const int sizeWidth = v41 ? data_size : 8;
+      file.skipLine();
+      const long long number_of_blocks = file.binaryUnsigned(sizeWidth);
+      file.binaryUnsigned(sizeWidth);     // number of nodes
+      if (v41)
+      {
+        file.binaryUnsigned(sizeWidth);   // minimum node tag
+        file.binaryUnsigned(sizeWidth);   // maximum node tag
+      }
+      for (long long b = 0; b < number_of_blocks; ++b)
+      {
+        int header[3];
+        file.binary(header, 3);
+        const int entityDim = v41 ? header[0] : header[1];
+        const long long count = file.binaryUnsigned(sizeWidth);
+        const int nCoords = 3 + (header[2] ? entityDim : 0);
+        file.skip(count * ((v41 ? sizeWidth : sizeof(int)) + nCoords*sizeof(double)));
+      }
+    }
 
-        for (int k=1; k<=number_of_tags; k++)
+    /** \brief Select the nodes needed for the elements of a slice
+     *
+     * Boundary elements are only kept if all their vertices are vertices of
+     * grid elements of the slice.
+     */
+    void selectNodes (ElementList& elements)
+    {
+      const int nVertices[12]  = {-1, 2, 3, 4, 4, 8, 6, 5, 2, 3, -1, 4};
+
+      auto addNodes = [&] (std::size_t i) {
+        const int* dofs = &elements.nodes[elements.offset[i]];
+        selected_nodes.insert(selected_nodes.end(), dofs, dofs + numberOfNodes(elements.type[i]));
+      };
+      auto sortNodes = [&] () {
+        std::sort(selected_nodes.begin(), selected_nodes.end());
+        selected_nodes.erase(std::unique(selected_nodes.begin(), selected_nodes.end()), selected_nodes.end());
+      };
+
+      selected_nodes.clear();
+      for (std::size_t i=0; i<elements.size(); i++)
+        if (isGridElement(elements.type[i]))
+          addNodes(i);
+      sortNodes();
+
+      ElementList selected;
+      for (std::size_t i=0; i<elements.size(); i++)
+      {
+        const int elm_type = elements.type[i];
+        const int* dofs = &elements.nodes[elements.offset[i]];
+        if (!isGridElement(elm_type))
         {
-          int blub;
-          readfile(file,1,"%d ",&blub);
-          if (k==1) physical_entity = blub;
+          bool inSlice = true;
+          for (int k=0; k<nVertices[elm_type]; k++)
+            inSlice = inSlice && std::binary_search(selected_nodes.begin(), selected_nodes.end(), dofs[k]);
+          if (!inSlice)
+            continue;
         }
-        pass2HandleElement(file, elm_type, renumber, nodes, physical_entity);
+        selected.push_back(elm_type, elements.physical_entity[i], dofs, numberOfNodes(elm_type));
       }
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$EndElements")!=0)
-        DUNE_THROW(Dune::IOError, "expected $EndElements");
+      std::swap(elements, selected);
 
-      fclose(file);
+      // the higher order nodes of boundary segments
+      for (std::size_t i=0; i<elements.size(); i++)
+        if (!isGridElement(elements.type[i]))
+          addNodes(i);
+      sortNodes();
+
+      select_nodes = true;
+      sparse_node_tags = true;
+      node_tag_to_index.reserve(selected_nodes.size());
     }
 
     /** \brief Process one element during the first pass through the list of all elements
@@ -409,41 +1346,22 @@ namespace Dune
      * Mainly, the method inserts all vertices needed by the current element,
      * unless they have been inserted already for a previous element.
      */
-    void pass1HandleElement(FILE* file, const int elm_type,
-                            std::map<int,unsigned int> & renumber,
+    void pass1HandleElement(const int elm_type, const int* elementDofs,
+                            std::vector<unsigned int> & renumber,
                             const std::vector< GlobalVector > & nodes)
     {
       // some data about gmsh elements
-      const int nDofs[12]      = {-1, 2, 3, 4, 4, 8, 6, 5, 3, 6, -1, 10};
       const int nVertices[12]  = {-1, 2, 3, 4, 4, 8, 6, 5, 2, 3, -1, 4};
       const int elementDim[12] = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, -1, 3};
 
-      // test whether we support the element type
-      if ( not (elm_type >= 0 && elm_type < 12         // index in suitable range?
-                && (elementDim[elm_type] == dim || elementDim[elm_type] == (dim-1) ) ) )         // real element or boundary element?
-      {
-        skipline(file);         // skip rest of line if element is unknown
-        return;
-      }
-
-      // The format string for parsing is n times '%d' in a row
-      std::string formatString = "%d";
-      for (int i=1; i<nDofs[elm_type]; i++)
-        formatString += " %d";
-      formatString += "\n";
-
-      // '10' is the largest number of dofs we may encounter in a .msh file
-      std::vector<int> elementDofs(10);
-
-      readfile(file,nDofs[elm_type], formatString.c_str(),
-               &(elementDofs[0]),&(elementDofs[1]),&(elementDofs[2]),
-               &(elementDofs[3]),&(elementDofs[4]),&(elementDofs[5]),
-               &(elementDofs[6]),&(elementDofs[7]),&(elementDofs[8]),
-               &(elementDofs[9]));
+      // all nodes, including those of higher order, have to be present
+      for (int i=0; i<numberOfNodes(elm_type); i++)
+        if (elementDofs[i] < 0 || std::size_t(elementDofs[i]) >= nodes.size())
+          DUNE_THROW(Dune::IOError, "Element refers to unknown node " << elementDofs[i] << ".");
 
       // insert each vertex if it hasn't been inserted already
       for (int i=0; i<nVertices[elm_type]; i++)
-        if (renumber.find(elementDofs[i])==renumber.end())
+        if (renumber[elementDofs[i]] == std::numeric_limits<unsigned int>::max())
         {
           renumber[elementDofs[i]] = number_of_real_vertices++;
           factory.insertVertex(nodes[elementDofs[i]]);
@@ -497,8 +1415,8 @@ namespace Dune
      *
      * This method actually inserts the element into the grid factory.
      */
-    virtual void pass2HandleElement(FILE* file, const int elm_type,
-                                    std::map<int,unsigned int> & renumber,
+    virtual void pass2HandleElement(const int elm_type, const int* dofs,
+                                    const std::vector<unsigned int> & renumber,
                                     const std::vector< GlobalVector > & nodes,
                                     const int physical_entity)
     {
@@ -507,28 +1425,9 @@ namespace Dune
       const int nVertices[12]  = {-1, 2, 3, 4, 4, 8, 6, 5, 2, 3, -1, 4};
       const int elementDim[12] = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, -1, 3};
 
-      // test whether we support the element type
-      if ( not (elm_type >= 0 && elm_type < 12         // index in suitable range?
-                && (elementDim[elm_type] == dim || elementDim[elm_type] == (dim-1) ) ) )         // real element or boundary element?
-      {
-        skipline(file);         // skip rest of line if element is unknown
-        return;
-      }
-
-      // The format string for parsing is n times '%d' in a row
-      std::string formatString = "%d";
-      for (int i=1; i<nDofs[elm_type]; i++)
-        formatString += " %d";
-      formatString += "\n";
-
       // '10' is the largest number of dofs we may encounter in a .msh file
-      std::vector<int> elementDofs(10);
-
-      readfile(file,nDofs[elm_type], formatString.c_str(),
-               &(elementDofs[0]),&(elementDofs[1]),&(elementDofs[2]),
-               &(elementDofs[3]),&(elementDofs[4]),&(elementDofs[5]),
-               &(elementDofs[6]),&(elementDofs[7]),&(elementDofs[8]),
-               &(elementDofs[9]));
+      std::array<int,10> elementDofs;
+      std::copy(dofs, dofs + nDofs[elm_type], elementDofs.begin());
 
       // correct differences between gmsh and Dune in the local vertex numbering
       switch (elm_type)
@@ -634,6 +1533,52 @@ namespace Dune
 
     }
 
+    /** \brief Process one element during the second pass, reading its nodes from a file
+     *
+     * This is the interface of the former reader, which read the element section from
+     * the file twice.  The node numbers of the element are read from 'file', and the
+     * element is handed to the overload above.
+     *
+     * \deprecated read() does not call this method anymore.  Readers that override it
+     *             have to override the overload above instead, which gets the node
+     *             numbers of the element and a renumbering indexed by node.
+     */
+    DUNE_DEPRECATED_MSG("pass2HandleElement(FILE*,...) is not called by read() anymore. Override the overload taking the node numbers instead.")
+    virtual void pass2HandleElement(FILE* file, const int elm_type,
+                                    std::map<int,unsigned int> & renumber,
+                                    const std::vector< GlobalVector > & nodes,
+                                    const int physical_entity)
+    {
+      const int nDofs[12]      = {-1, 2, 3, 4, 4, 8, 6, 5, 3, 6, -1, 10};
+      const int elementDim[12] = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, -1, 3};
+
+      // read the rest of the line; only elements and boundary elements are handled
+      char line[4096];
+      if (std::fgets(line, sizeof(line), file) == 0)
+        DUNE_THROW(Dune::IOError, "Could not read element from file");
+      if ( not (elm_type >= 0 && elm_type < 12
+                && (elementDim[elm_type] == dim || elementDim[elm_type] == (dim-1) ) ) )
+        return;
+
+      std::array<int,10> dofs;
+      const char* p = line;
+      for (int i=0; i<nDofs[elm_type]; i++)
+      {
+        char* q;
+        dofs[i] = std::strtol(p, &q, 10);
+        if (q == p)
+          DUNE_THROW(Dune::IOError, "Could not read element from file");
+        p = q;
+      }
+
+      std::vector<unsigned int> renumberVector(renumber.empty() ? 0 : renumber.rbegin()->first + 1,
+                                               std::numeric_limits<unsigned int>::max());
+      for (const auto& r : renumber)
+        renumberVector[r.first] = r.second;
+
+      pass2HandleElement(elm_type, dofs.data(), renumberVector, nodes, physical_entity);
+    }
+
   };
 
   /**
@@ -651,6 +1596,10 @@ namespace Dune
      All grids in a gmsh file live in three-dimensional Euclidean space.  If the world dimension
      of the grid type that you are reading the file into is less than three, the remaining coordinates
      are simply ignored.
+
+     Files of the MSH formats 2.x and 4.x can be read, both in ASCII and in binary encoding.
+     In MSH 4 files, the physical entity of an element is the first physical tag of the
+     geometrical entity it belongs to, or 0 if there is none.
    */
   template<typename GridType>
   class GmshReader
@@ -713,6 +1662,33 @@ namespace Dune
       boundarySegmentToPhysicalEntity.swap(parser.boundaryIdMap());
       elementToPhysicalEntity.swap(parser.elementIndexMap());
     }
+
+    /** \brief Read one slice of a file into a grid factory
+     *
+     * The grid elements of the file are split into \p numberOfSlices contiguous
+     * chunks in the order of the file. Only the elements of chunk \p slice,
+     * the vertices they use, and the boundary segments on these vertices are
+     * inserted into the factory; the rest of the file is never stored. In
+     * binary files, the elements of other slices are skipped without parsing.
+     *
+     * Each process of a parallel program can read its own slice like this,
+     * if the grid factory accepts distributed input. The physical entity
+     * vectors refer to the elements and boundary segments of the slice.
+     */
+    static void readSlice (Dune::GridFactory<Grid>& factory,
+                           const std::string& fileName,
+                           int slice, int numberOfSlices,
+                           std::vector<int>& boundarySegmentToPhysicalEntity,
+                           std::vector<int>& elementToPhysicalEntity,
+                           bool verbose = true, bool insertBoundarySegments=true)
+    {
+      // create parse object
+      GmshReaderParser<Grid> parser(factory,verbose,insertBoundarySegments);
+      parser.read(fileName, slice, numberOfSlices);
+
+      boundarySegmentToPhysicalEntity.swap(parser.boundaryIdMap());
+      elementToPhysicalEntity.swap(parser.elementIndexMap());
+    }
   };
 
   /** \} */
@@ -3,9 +3,15 @@
 #ifndef DUNE_GRID_IO_FILE_GMSHWRITER_HH
 #define DUNE_GRID_IO_FILE_GMSHWRITER_HH
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -17,12 +23,30 @@
 
 namespace Dune {
 
+  //! Options for write operation
+  struct GmshWriterOptions
+  {
+    enum FileFormat {
+      /** @brief ASCII file of version 2.0. */
+      ascii,
+      /** @brief binary file of version 2.2. */
+      binary,
+      /** @brief ASCII file of version 4.1. */
+      ascii4,
+      /** @brief binary file of version 4.1. */
+      binary4
+    };
+  };
+
   /**
      \ingroup Gmsh
 
      \brief Write Gmsh mesh file
 
-     Write a grid using the given GridView as an ASCII Gmsh file of version 2.0.
+     Write a grid using the given GridView as a Gmsh file. By default, an ASCII file
+     of version 2.0 is written, binary files of version 2.2 and ASCII or binary files
+     of version 4.1 can be selected with setFormat(). Data on the vertices and on the
+     elements can be added to the file as $NodeData and $ElementData sections.
 
      If the grid contains an element type not supported by gmsh an IOError exception is thrown.
 
@@ -36,11 +60,41 @@ namespace Dune {
   private:
     const GridView gv;
     int precision;
+    GmshWriterOptions::FileFormat format;
 
     static const unsigned int dim = GridView::dimension;
     static const unsigned int dimWorld = GridView::dimensionworld;
     static_assert( (dimWorld <= 3), "GmshWriter requires dimWorld <= 3." );
 
+    typedef MultipleCodimMultipleGeomTypeMapper<GridView> Mapper;
+
+    //! data added with addNodeData() or addElementData()
+    struct Data
+    {
+      std::string name;
+      int ncomps;
+      std::function<double(std::size_t)> value;
+    };
+    std::vector<Data> nodeData;
+    std::vector<Data> elementData;
+
+    //! a block of elements of the same type on the same entity
+    struct Block
+    {
+      int entityDim;
+      int entityTag;
+      int type;
+      std::size_t count;
+    };
+
+    //! a geometrical entity of a version 4 file, one for each physical entity
+    struct GmshEntity
+    {
+      int tag = 0;
+      std::array<double,3> lower;
+      std::array<double,3> upper;
+    };
+
     /** \brief Returns index of i-th vertex of an element, plus 1 (for gmsh numbering) */
     template<typename Entity>
     std::size_t nodeIndexFromEntity(const Entity& entity, int i) const {
@@ -75,105 +129,364 @@ namespace Dune {
       return element_type;
     }
 
-    /** \brief Writes all the elements of a grid line by line
+    bool isBinary() const {
+      return format == GmshWriterOptions::binary || format == GmshWriterOptions::binary4;
+    }
+
+    bool isVersion4() const {
+      return format == GmshWriterOptions::ascii4 || format == GmshWriterOptions::binary4;
+    }
+
+    /** \brief Write a line of values
      *
-     * Each line has the format
+     * In ASCII files, the values are separated by blanks and followed by a newline,
+     * in binary files the raw values are written in one block.
+     */
+    template<typename T>
+    void writeValues(std::ofstream& file, const T* values, std::size_t n) const {
+      if (isBinary())
+        file.write(reinterpret_cast<const char*>(values), n*sizeof(T));
+      else {
+        for (std::size_t i = 0; i < n; ++i)
+          file << (i > 0 ? " " : "") << values[i];
+        file << '\n';
+      }
+    }
+
+    //! end a section of binary data, which is followed by a newline
+    void endBinary(std::ofstream& file) const {
+      if (isBinary())
+        file << '\n';
+    }
+
+    /** \brief Collect the corner node numbers of a Gmsh element
+     *
+     * 3, 5 and 7 got different vertex numbering compared to Dune
+     */
+    template<typename Element>
+    std::size_t elementNodes(const Element& entity, std::size_t element_type, std::size_t* nodes) const {
+      const std::size_t corners = entity.subEntities(dim);
+      for (std::size_t k = 0; k < corners; ++k)
+        nodes[k] = nodeIndexFromEntity(entity, k);
+      if (3 == element_type || 5 == element_type || 7 == element_type)
+        std::swap(nodes[2], nodes[3]);
+      if (5 == element_type)
+        std::swap(nodes[6], nodes[7]);
+      return corners;
+    }
+
+    /** \brief Call f(element, gmshType, physical) for each element and
+     *         f(element, intersection, gmshType, physical) for each boundary intersection
+     *
+     * All elements come first, then all boundary segments (if `physicalBoundaries` is not empty).
+     * A physical value of 0 is passed if `physicalEntities` is empty.
+     */
+    template<typename ElementFunction, typename BoundaryFunction>
+    void forEachElement(const std::vector<int>& physicalEntities, const std::vector<int>& physicalBoundaries,
+                        ElementFunction&& elementFunction, BoundaryFunction&& boundaryFunction) const {
+      Mapper elementMapper(gv, mcmgElementLayout());
+      for (const auto& entity : elements(gv)) {
+        const int physical = physicalEntities.empty() ? 0 : physicalEntities[elementMapper.index(entity)];
+        elementFunction(entity, translateDuneToGmshType(entity.type()), physical);
+      }
+
+      if (!physicalBoundaries.empty())
+        for (const auto& entity : elements(gv))
+          for (const auto& intersection : intersections(gv, entity))
+            if (intersection.boundary())
+              boundaryFunction(entity, intersection, translateDuneToGmshType(intersection.type()),
+                               physicalBoundaries[intersection.boundarySegmentIndex()]);
+    }
+
+    /** \brief Add the corners of an element to the bounding box of the entity of its physical value
+     *
+     * \returns the tag of the entity
+     */
+    template<typename Geometry>
+    static int updateEntity(std::map<int,GmshEntity>& entities, int physical, const Geometry& geometry) {
+      auto& entity = entities[physical];
+      if (entity.tag == 0) {
+        entity.tag = entities.size();
+        entity.lower.fill(std::numeric_limits<double>::max());
+        entity.upper.fill(std::numeric_limits<double>::lowest());
+        for (unsigned int i = dimWorld; i < 3; ++i)
+          entity.lower[i] = entity.upper[i] = 0.0;
+      }
+      for (int k = 0; k < geometry.corners(); ++k) {
+        const auto x = geometry.corner(k);
+        for (unsigned int i = 0; i < dimWorld; ++i) {
+          entity.lower[i] = std::min(entity.lower[i], double(x[i]));
+          entity.upper[i] = std::max(entity.upper[i], double(x[i]));
+        }
+      }
+      return entity.tag;
+    }
+
+    /** \brief Split the elements into blocks of the same type, dimension and (in version 4) physical entity
+     *
+     * For version 4 files, one geometrical entity is created for each physical
+     * entity of each dimension, with the bounding box of its elements.
+     */
+    std::vector<Block> elementBlocks(const std::vector<int>& physicalEntities, const std::vector<int>& physicalBoundaries,
+                                     std::array<std::map<int,GmshEntity>,2>& entities) const {
+      std::vector<Block> blocks;
+      auto add = [&] (int entityDim, int physical, std::size_t type, const auto& geometry) {
+        int entityTag = 0;
+        if (isVersion4())
+          entityTag = updateEntity(entities[entityDim == int(dim) ? 0 : 1], physical, geometry);
+
+        if (blocks.empty() || blocks.back().entityDim != entityDim || blocks.back().entityTag != entityTag
+            || blocks.back().type != int(type))
+          blocks.push_back(Block{entityDim, entityTag, int(type), 0});
+        ++blocks.back().count;
+      };
+
+      forEachElement(physicalEntities, physicalBoundaries,
+                     [&] (const auto& entity, std::size_t type, int physical) {
+                       add(dim, physical, type, entity.geometry());
+                     },
+                     [&] (const auto& entity, const auto& intersection, std::size_t type, int physical) {
+                       add(dim-1, physical, type, intersection.geometry());
+                     });
+      return blocks;
+    }
+
+    //! Writes the $Entities section of a version 4 file
+    void outputEntities(std::ofstream& file, const std::array<std::map<int,GmshEntity>,2>& entities,
+                        bool elementsHavePhysical) const {
+      file << "$Entities\n";
+      std::array<std::size_t,4> counts = {{0, 0, 0, 0}};
+      counts[dim] = entities[0].size();
+      if (dim > 0)
+        counts[dim-1] = entities[1].size();
+      writeValues(file, counts.data(), 4);
+
+      for (int d = 0; d < 4; ++d) {
+        if (d != int(dim) && d+1 != int(dim))
+          continue;
+        for (const auto& e : entities[d == int(dim) ? 0 : 1]) {
+          const int tag = e.second.tag;
+          const int physical = e.first;
+          const std::size_t numPhysicals = (d < int(dim) || elementsHavePhysical) ? 1 : 0, none = 0;
+          writeEntityValues(file, &tag, 1);
+          // points only have coordinates, all other entities have a bounding box
+          writeEntityValues(file, e.second.lower.data(), 3);
+          if (d > 0)
+            writeEntityValues(file, e.second.upper.data(), 3);
+          writeEntityValues(file, &numPhysicals, 1);
+          writeEntityValues(file, &physical, numPhysicals);
+          // the bounding entities are not written
+          if (d > 0)
+            writeEntityValues(file, &none, 1);
+          if (!isBinary())
+            file << '\n';
+        }
+      }
+      endBinary(file);
+      file << "$EndEntities\n";
+    }
+
+    //! write values on a line of the $Entities section, the caller adds the newline in ASCII files
+    template<typename T>
+    void writeEntityValues(std::ofstream& file, const T* values, std::size_t n) const {
+      if (isBinary())
+        file.write(reinterpret_cast<const char*>(values), n*sizeof(T));
+      else
+        for (std::size_t i = 0; i < n; ++i)
+          file << values[i] << " ";
+    }
+
+    /** \brief Writes all the elements of a grid
+     *
+     * In ASCII files of version 2, each line has the format
      *    element-number element-type number-of-tags <tags> node-number-list
      * Counting of the element numbers starts by "1".
      *
      * If `physicalEntities` is not empty, each element has a tag representing its physical id.
      *
      * If `physicalBoundaries` is not empty, also the boundaries are written to the file with
-     * the corresponding physical value.
+     * the corresponding physical value, after all elements.
      *
      * The physicalBoundaries vector need to be sorted according to the interesection
      * boundary segment index.
      */
-    void outputElements(std::ofstream& file, const std::vector<int>& physicalEntities, const std::vector<int>& physicalBoundaries) const {
-      MultipleCodimMultipleGeomTypeMapper<GridView> elementMapper(gv, mcmgElementLayout());
+    void outputElements(std::ofstream& file, const std::vector<int>& physicalEntities, const std::vector<int>& physicalBoundaries,
+                        const std::vector<Block>& blocks) const {
       std::size_t counter(1);
-      for (const auto& entity : elements(gv)) {
-        // Check whether the type is compatible. If not, close file and rethrow exception.
-        try {
-          std::size_t element_type = translateDuneToGmshType(entity.type());
-
-          file << counter << " " << element_type;
-          // If present, set the first tag to the physical entity
-          if (!physicalEntities.empty())
-            file << " " << 1 << " " << physicalEntities[elementMapper.index(entity)];
-          else
-            file << " " << 0; // "0" for "I do not use any tags."
-
-          // Output list of nodes.
-          // 3, 5 and 7 got different vertex numbering compared to Dune
-          if (3 == element_type)
-            file << " "
-                 << nodeIndexFromEntity(entity, 0) << " " << nodeIndexFromEntity(entity, 1) << " "
-                 << nodeIndexFromEntity(entity, 3) << " " << nodeIndexFromEntity(entity, 2);
-          else if (5 == element_type)
-            file << " "
-                 << nodeIndexFromEntity(entity, 0) << " " << nodeIndexFromEntity(entity, 1) << " "
-                 << nodeIndexFromEntity(entity, 3) << " " << nodeIndexFromEntity(entity, 2) << " "
-                 << nodeIndexFromEntity(entity, 4) << " " << nodeIndexFromEntity(entity, 5) << " "
-                 << nodeIndexFromEntity(entity, 7) << " " << nodeIndexFromEntity(entity, 6);
-          else if (7 == element_type)
-            file << " "
-                 << nodeIndexFromEntity(entity, 0) << " " << nodeIndexFromEntity(entity, 1) << " "
-                 << nodeIndexFromEntity(entity, 3) << " " << nodeIndexFromEntity(entity, 2) << " "
-                 << nodeIndexFromEntity(entity, 4);
-          else {
-            for (int k = 0; k < entity.geometry().corners(); ++k)
-              file << " " << nodeIndexFromEntity(entity, k);
-          }
-          ++counter;
-
-          file << std::endl;
-
-          // Write boundaries
-          if (!physicalBoundaries.empty()) {
-            const auto& refElement(ReferenceElements<typename GridView::ctype,dim>::general(entity.type()));
-            for(const auto& intersection : intersections(gv, entity)) {
-              if(intersection.boundary()) {
-                const auto faceLocalIndex(intersection.indexInInside());
-                file << counter << " " << translateDuneToGmshType(intersection.type())
-                  << " " << 1 << " " << physicalBoundaries[intersection.boundarySegmentIndex()];
-                for (int k = 0; k < intersection.geometry().corners(); ++k)
-                {
-                  const auto vtxLocalIndex(refElement.subEntity(faceLocalIndex, 1, k, dim));
-                  file << " " << nodeIndexFromEntity(entity, vtxLocalIndex);
-                }
-                ++counter;
-                file << std::endl;
-              }
+      auto block = blocks.begin();
+      std::size_t left = 0;
+      // element number, element type, number of tags, 1 tag and at most 8 nodes
+      constexpr std::size_t maxCorners = 8;
+      std::array<std::size_t, 4 + maxCorners> record;
+      std::array<int, 4 + maxCorners> intRecord;
+
+      auto write = [&] (std::size_t type, int physical, bool hasTag, const std::size_t* nodes, std::size_t corners) {
+        // start a new block
+        if (left == 0) {
+          left = block->count;
+          if (isVersion4()) {
+            const int header[3] = {block->entityDim, block->entityTag, block->type};
+            if (isBinary()) {
+              file.write(reinterpret_cast<const char*>(header), sizeof(header));
+              file.write(reinterpret_cast<const char*>(&block->count), sizeof(std::size_t));
             }
+            else
+              file << header[0] << " " << header[1] << " " << header[2] << " " << block->count << '\n';
           }
-
-        } catch(Exception& e) {
-          file.close();
-          throw;
+          else if (isBinary()) {
+            const int header[3] = {block->type, int(block->count), hasTag ? 1 : 0};
+            file.write(reinterpret_cast<const char*>(header), sizeof(header));
+          }
+          ++block;
         }
-      }
+        --left;
+
+        assert(corners <= maxCorners);
+        if (isVersion4()) {
+          // element tag and nodes, all as size_t
+          record[0] = counter;
+          std::copy(nodes, nodes + corners, record.begin() + 1);
+          writeValues(file, record.data(), 1 + corners);
+        }
+        else {
+          // the ASCII format additionally has the element type and the number of tags
+          std::size_t n = 0;
+          intRecord[n++] = counter;
+          if (!isBinary()) {
+            intRecord[n++] = type;
+            intRecord[n++] = hasTag ? 1 : 0;
+          }
+          if (hasTag)
+            intRecord[n++] = physical;
+          for (std::size_t k = 0; k < corners; ++k)
+            intRecord[n++] = nodes[k];
+          writeValues(file, intRecord.data(), n);
+        }
+        ++counter;
+      };
+
+      std::array<std::size_t, maxCorners> nodes;
+      forEachElement(physicalEntities, physicalBoundaries,
+                     [&] (const auto& entity, std::size_t type, int physical) {
+                       const std::size_t corners = elementNodes(entity, type, nodes.data());
+                       write(type, physical, !physicalEntities.empty(), nodes.data(), corners);
+                     },
+                     [&] (const auto& entity, const auto& intersection, std::size_t type, int physical) {
+                       const auto& refElement(ReferenceElements<typename GridView::ctype,dim>::general(entity.type()));
+                       const auto faceLocalIndex(intersection.indexInInside());
+                       const std::size_t corners = refElement.size(faceLocalIndex, 1, dim);
+                       for (std::size_t k = 0; k < corners; ++k)
+                         nodes[k] = nodeIndexFromEntity(entity, refElement.subEntity(faceLocalIndex, 1, k, dim));
+                       write(type, physical, true, nodes.data(), corners);
+                     });
+      endBinary(file);
     }
 
 
-    /** \brief Writes all the vertices of a grid line by line
+    /** \brief Writes all the vertices of a grid
      *
-     * Each line has the format
+     * In ASCII files of version 2, each line has the format
      *  node-number x-coord y-coord z-coord
      * The node-numbers will most certainly not have the arrangement "1, 2, 3, ...".
      */
     void outputNodes(std::ofstream& file) const {
+      const std::size_t numberOfNodes = gv.size(dim);
+
+      if (isVersion4()) {
+        // a single block of all nodes, on the first entity of the elements
+        const std::size_t header[4] = {1, numberOfNodes, 1, numberOfNodes};
+        writeValues(file, header, 4);
+        const int blockHeader[3] = {int(dim), 1, 0};
+        if (isBinary()) {
+          file.write(reinterpret_cast<const char*>(blockHeader), sizeof(blockHeader));
+          file.write(reinterpret_cast<const char*>(&numberOfNodes), sizeof(std::size_t));
+        }
+        else
+          file << blockHeader[0] << " " << blockHeader[1] << " " << blockHeader[2] << " " << numberOfNodes << '\n';
+
+        // first all node numbers, then all coordinates
+        for (const auto& vertex : vertices(gv)) {
+          const std::size_t nodeIndex = gv.indexSet().index(vertex)+1;
+          writeValues(file, &nodeIndex, 1);
+        }
+      }
+      else
+        file << numberOfNodes << '\n';
+
       for (const auto& vertex : vertices(gv)) {
         const auto globalCoord = vertex.geometry().center();
-        const auto nodeIndex = gv.indexSet().index(vertex)+1; // Start counting indices by "1".
-
-        if (1 == dimWorld)
-          file << nodeIndex << " " << globalCoord[0] << " " << 0 << " " << 0 << std::endl;
-        else if (2 == dimWorld)
-          file << nodeIndex << " " << globalCoord[0] << " " << globalCoord[1] << " " << 0 << std::endl;
-        else // (3 == dimWorld)
-          file << nodeIndex << " " << globalCoord[0] << " " << globalCoord[1] << " " << globalCoord[2] << std::endl;
+        std::array<double,3> x = {{0.0, 0.0, 0.0}};
+        for (unsigned int i = 0; i < dimWorld; ++i)
+          x[i] = globalCoord[i];
+
+        if (isVersion4())
+          writeValues(file, x.data(), 3);
+        else if (isBinary()) {
+          const int nodeIndex = gv.indexSet().index(vertex)+1; // Start counting indices by "1".
+          file.write(reinterpret_cast<const char*>(&nodeIndex), sizeof(int));
+          file.write(reinterpret_cast<const char*>(x.data()), 3*sizeof(double));
+        }
+        else {
+          const auto nodeIndex = gv.indexSet().index(vertex)+1; // Start counting indices by "1".
+          file << nodeIndex;
+          for (unsigned int i = 0; i < 3; ++i) {
+            // keep the integer output of missing coordinates
+            if (i < dimWorld)
+              file << " " << x[i];
+            else
+              file << " " << 0;
+          }
+          file << '\n';
+        }
       }
+      endBinary(file);
+    }
+
+    /** \brief Writes a $NodeData or $ElementData section
+     *
+     * Gmsh only knows scalars, vectors and tensors with 1, 3 and 9 components,
+     * vectors with 2 components are filled up with a zero.
+     */
+    template<typename Entities>
+    void outputData(std::ofstream& file, const std::string& section, const Data& data, std::size_t count,
+                    const Mapper& mapper, const Entities& entities, bool useIndexSet) const {
+      const int ncomps = (data.ncomps == 2) ? 3 : data.ncomps;
+
+      file << "$" << section << '\n'
+           << 1 << '\n' << "\"" << data.name << "\"" << '\n'     // name
+           << 1 << '\n' << 0.0 << '\n'                            // time
+           << 3 << '\n' << 0 << '\n' << ncomps << '\n' << count << '\n';  // time step, components, number of values
+
+      std::size_t counter(1);
+      std::array<double, 9> values;
+      for (const auto& entity : entities) {
+        const std::size_t index = mapper.index(entity);
+        const int tag = useIndexSet ? gv.indexSet().index(entity)+1 : counter++;
+        values.fill(0.0);
+        for (int c = 0; c < data.ncomps; ++c)
+          values[c] = data.value(index*data.ncomps + c);
+
+        if (isBinary()) {
+          file.write(reinterpret_cast<const char*>(&tag), sizeof(int));
+          file.write(reinterpret_cast<const char*>(values.data()), ncomps*sizeof(double));
+        }
+        else {
+          file << tag;
+          for (int c = 0; c < ncomps; ++c)
+            file << " " << values[c];
+          file << '\n';
+        }
+      }
+      endBinary(file);
+      file << "$End" << section << '\n';
+    }
+
+    //! check the number of components of data and store it
+    template<typename Container>
+    static void addData(std::vector<Data>& data, const Container& v, const std::string& name, int ncomps) {
+      if (ncomps != 1 && ncomps != 2 && ncomps != 3 && ncomps != 9)
+        DUNE_THROW(Dune::IOError, "Gmsh only supports data with 1, 3 or 9 components, not " << ncomps << ".");
+      data.push_back(Data{name, ncomps, [&v] (std::size_t i) { return double(v[i]); }});
     }
 
   public:
@@ -181,8 +494,11 @@ namespace Dune {
      * \brief Constructor expecting GridView of Grid to be written.
      * \param gridView GridView that will be written.
      * \param numDigits Number of digits to use.
+     * \param fileFormat Format of the file.
      */
-    GmshWriter(const GridView& gridView, int numDigits=6) : gv(gridView), precision(numDigits) {}
+    GmshWriter(const GridView& gridView, int numDigits=6,
+               GmshWriterOptions::FileFormat fileFormat=GmshWriterOptions::ascii)
+      : gv(gridView), precision(numDigits), format(fileFormat) {}
 
     /**
      * \brief Set the number of digits to be used when writing the vertices. By default is 6.
@@ -193,7 +509,46 @@ namespace Dune {
     }
 
     /**
-     * \brief Write given grid in Gmsh 2.0 compatible ASCII file.
+     * \brief Set the format of the file, by default an ASCII file of version 2.0 is written.
+     * \param fileFormat Format of the file.
+     */
+    void setFormat(GmshWriterOptions::FileFormat fileFormat) {
+      format = fileFormat;
+    }
+
+    /**
+     * \brief Add data on the vertices of the grid, written as a $NodeData section.
+     *
+     * The container has to have random access via operator[] (e.g. std::vector). The
+     * value for a vertex is accessed with the index of the vertex from the MCMG mapper
+     * on the grid view; for ncomps components, the entries ncomps*index to
+     * ncomps*index+ncomps-1 are used. The container is stored by reference and has to
+     * be valid until write() is called.
+     */
+    template<typename Container>
+    void addNodeData(const Container& v, const std::string& name, int ncomps=1) {
+      addData(nodeData, v, name, ncomps);
+    }
+
+    /**
+     * \brief Add data on the elements of the grid, written as an $ElementData section.
+     *
+     * The container is accessed like in addNodeData(), with the element index
+     * from the MCMG mapper.
+     */
+    template<typename Container>
+    void addElementData(const Container& v, const std::string& name, int ncomps=1) {
+      addData(elementData, v, name, ncomps);
+    }
+
+    //! clear the list of added data
+    void clear() {
+      nodeData.clear();
+      elementData.clear();
+    }
+
+    /**
+     * \brief Write given grid in a Gmsh file.
      * \param fileName Path of file. This method does not attach a ".msh"-extension by itself.
      * \param physicalEntities Physical entities for each element (optional).
      * \param physicalBoundaries Physical boundaries (optional).
@@ -217,7 +572,7 @@ namespace Dune {
                const std::vector<int>& physicalEntities=std::vector<int>(),
                const std::vector<int>& physicalBoundaries=std::vector<int>()) const {
       // Open file
-      std::ofstream file(fileName.c_str());
+      std::ofstream file(fileName.c_str(), std::ios::binary);
       if (!file.is_open())
         DUNE_THROW(Dune::IOError, "Could not open " << fileName << " with write access.");
 
@@ -225,32 +580,75 @@ namespace Dune {
       file << std::setprecision( precision );
 
       // Output Header
-      file << "$MeshFormat" << std::endl
-           << "2.0 0 " << sizeof(double) << std::endl // "2.0" for "version 2.0", "0" for ASCII
-           << "$EndMeshFormat" << std::endl;
+      file << "$MeshFormat" << '\n';
+      if (isVersion4())
+        file << "4.1 ";
+      else if (isBinary())
+        file << "2.2 ";
+      else
+        file << "2.0 ";                     // "2.0" for "version 2.0"
+      // data-size is the size of the integer fields (std::size_t) in 4.1, of a double in 2.x
+      const std::size_t dataSize = isVersion4() ? sizeof(std::size_t) : sizeof(double);
+      file << (isBinary() ? 1 : 0) << " " << dataSize << '\n';   // "0" for ASCII
+      if (isBinary()) {
+        // allows the reader to detect the byte order
+        const int one = 1;
+        file.write(reinterpret_cast<const char*>(&one), sizeof(int));
+        file << '\n';
+      }
+      file << "$EndMeshFormat" << '\n';
+
+      // Group the elements into blocks, this fails for unsupported element types
+      std::array<std::map<int,GmshEntity>,2> entities;
+      std::vector<Block> blocks;
+      try {
+        blocks = elementBlocks(physicalEntities, physicalBoundaries, entities);
+      } catch(Exception& e) {
+        file.close();
+        throw;
+      }
+
+      if (isVersion4())
+        outputEntities(file, entities, !physicalEntities.empty());
 
       // Output Nodes
-      file << "$Nodes" << std::endl
-           << gv.size(dim) << std::endl;
+      file << "$Nodes" << '\n';
 
       outputNodes(file);
 
-      file << "$EndNodes" << std::endl;
+      file << "$EndNodes" << '\n';
 
       // Output Elements;
-      int boundariesSize(0);
-      if(!physicalBoundaries.empty())
-        for(const auto& entity : elements(gv))
-          for(const auto& intersection : intersections(gv, entity))
-            if(intersection.boundary())
-              ++boundariesSize;
+      std::size_t numberOfElements(0);
+      for (const auto& block : blocks)
+        numberOfElements += block.count;
+
+      file << "$Elements" << '\n';
+      if (isVersion4()) {
+        const std::size_t header[4] = {blocks.size(), numberOfElements, 1, numberOfElements};
+        writeValues(file, header, 4);
+      }
+      else
+        file << numberOfElements << '\n';
 
-      file << "$Elements" << std::endl
-           << gv.size(0) + boundariesSize<< std::endl;
+      outputElements(file, physicalEntities, physicalBoundaries, blocks);
 
-      outputElements(file, physicalEntities, physicalBoundaries);
+      file << "$EndElements" << '\n';
+
+      // Output data
+      if (!nodeData.empty()) {
+        Mapper vertexMapper(gv, mcmgVertexLayout());
+        for (const auto& data : nodeData)
+          outputData(file, "NodeData", data, gv.size(dim), vertexMapper, vertices(gv), true);
+      }
+      if (!elementData.empty()) {
+        Mapper elementMapper(gv, mcmgElementLayout());
+        for (const auto& data : elementData)
+          outputData(file, "ElementData", data, gv.size(0), elementMapper, elements(gv), false);
+      }
 
-      file << "$EndElements" << std::endl;
+      if (!file)
+        DUNE_THROW(Dune::IOError, "Could not write " << fileName << ".");
     }
 
   };
@@ -3,14 +3,162 @@
 #ifndef DUNE_STARCD_READER_HH
 #define DUNE_STARCD_READER_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <dune/common/exceptions.hh>
 #include <dune/geometry/type.hh>
 #include <dune/grid/common/gridfactory.hh>
-#include <iostream>
-#include <fstream>
 
 namespace Dune {
 
+  namespace Impl {
+
+    /** \brief Content of a Star-CD file, split into chunks of whole lines
+     *
+     *  The file is read into memory in one go. The chunks can be parsed
+     *  independently, each by its own thread.
+     */
+    class StarCDFile
+    {
+    public:
+      //! default for the minimal size of a chunk in bytes, small files are not worth the threads
+      static const std::size_t defaultMinChunkSize = 1 << 20;
+
+      StarCDFile (const std::string& fileName, unsigned int numChunks,
+                  std::size_t minChunkSize = defaultMinChunkSize)
+      {
+        FILE* file = std::fopen(fileName.c_str(), "rb");
+        if (file == 0)
+          DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+
+        std::fseek(file, 0, SEEK_END);
+        const long size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (size < 0)
+        {
+          std::fclose(file);
+          DUNE_THROW(Dune::IOError, "Could not determine the size of " << fileName);
+        }
+
+        // terminate the data, so that strtod and friends stop at the end of the buffer
+        data_.resize(size + 1);
+        const std::size_t n = std::fread(data_.data(), 1, size, file);
+        std::fclose(file);
+        if (n != std::size_t(size))
+          DUNE_THROW(Dune::IOError, "Could not read " << fileName);
+        data_[size] = '\0';
+
+        // split at line ends
+        numChunks = std::max(1L, std::min(long(numChunks), size / long(std::max<std::size_t>(minChunkSize, 1))));
+        chunks_.push_back(data_.data());
+        for (unsigned int i = 1; i < numChunks; ++i)
+        {
+          const char* p = std::max<const char*>(chunks_.back(), data_.data() + (size * i) / numChunks);
+          while (p > data_.data() && p < data_.data() + size && *(p-1) != '\n')
+            ++p;
+          chunks_.push_back(p);
+        }
+        chunks_.push_back(data_.data() + size);
+      }
+
+      //! number of chunks
+      unsigned int size () const
+      {
+        return chunks_.size() - 1;
+      }
+
+      //! first character of the i-th chunk
+      const char* begin (unsigned int i) const
+      {
+        return chunks_[i];
+      }
+
+      //! one past the last character of the i-th chunk
+      const char* end (unsigned int i) const
+      {
+        return chunks_[i+1];
+      }
+
+      /** \brief parse all chunks in parallel
+       *
+       *  \param parseChunk function called as parseChunk(begin, end, result) for each chunk
+       *  \return the results of all chunks, in the order of the file
+       */
+      template <class Result, class ParseChunk>
+      std::vector<Result> parse (ParseChunk parseChunk) const
+      {
+        std::vector<Result> results(size());
+        std::vector<std::thread> threads;
+        std::vector<std::string> errors(size());
+        auto work = [&] (unsigned int i) {
+                      try {
+                        parseChunk(begin(i), end(i), results[i]);
+                      }
+                      catch (Dune::Exception& e) {
+                        errors[i] = e.what();
+                      }
+                      catch (std::exception& e) {
+                        errors[i] = e.what();
+                      }
+                    };
+        for (unsigned int i = 1; i < size(); ++i)
+          threads.emplace_back(work, i);
+        work(0);
+        for (std::thread& thread : threads)
+          thread.join();
+
+        for (const std::string& error : errors)
+          if (!error.empty())
+            DUNE_THROW(Dune::IOError, error);
+        return results;
+      }
+
+      //! skip whitespace, returns false at the end of the chunk
+      static bool skipWhitespace (const char*& p, const char* end)
+      {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+          ++p;
+        return p < end;
+      }
+
+      //! parse an integer
+      static long readInteger (const char*& p, const char* end)
+      {
+        char* q;
+        const long value = std::strtol(p, &q, 10);
+        if (q == p || q > end)
+          DUNE_THROW(Dune::IOError, "Expected an integer in Star-CD file");
+        p = q;
+        return value;
+      }
+
+      //! parse a floating point number
+      static double readDouble (const char*& p, const char* end)
+      {
+        char* q;
+        const double value = std::strtod(p, &q);
+        if (q == p || q > end)
+          DUNE_THROW(Dune::IOError, "Expected a number in Star-CD file");
+        p = q;
+        return value;
+      }
+
+    private:
+      std::vector<char> data_;
+      std::vector<const char*> chunks_;
+    };
+
+  } // namespace Impl
+
   /** @ingroup StarCD
    *    \brief File reader for the Star-CD format.
    *
@@ -42,135 +190,171 @@ namespace Dune {
    *
    *    This reader only supports three-dimensional grids.
    *
+   *    Both files are read into memory at once and parsed by several threads.
+   *    The vertices and elements are inserted into the grid factory afterwards
+   *    by GridFactoryInterface::insertVertices and insertElements, in the order
+   *    of the files.
+   *
    *    Currently no boundary element data is passed to \a grid.
    */
   template <class GridType>
   class StarCDReader {
 
+    static const int dim = GridType::dimension;
+
+    typedef typename GridType::ctype ctype;
+
+    // the volume elements of a chunk of the element file, in the format of GridFactory::insertElements
+    struct Elements
+    {
+      std::vector<GeometryType> types;
+      std::vector<unsigned int> offsets = std::vector<unsigned int>(1, 0);
+      std::vector<unsigned int> vertices;
+      int counts[4] = {0, 0, 0, 0};
+    };
+
   public:
 
     /** \brief Read grid from a Star-CD file
      *    \return Pointer to the grid
      *    \param fileName The base file name of the Star-CD files
      *    \param verbose Tlag to set whether information should be printed
+     *    \param numThreads Number of threads used for parsing, 0 selects
+     *                      the number of hardware threads
      */
-    static GridType* read(const std::string& fileName, bool verbose = true)
+    static GridType* read(const std::string& fileName, bool verbose = true, unsigned int numThreads = 0)
     {
-      // extract the grid dimension
-      const int dim = GridType::dimension;
+      // set up the grid factory
+      GridFactory<GridType> factory;
+
+      read(factory, fileName, verbose, numThreads);
+
+      // finish off the construction of the grid object
+      if (verbose)
+        std::cout << "Starting createGrid() ... " << std::flush;
 
+      return factory.createGrid();
+    }
+
+    /** \brief Read grid from a Star-CD file into a grid factory
+     *    \param factory The grid factory to fill
+     *    \param fileName The base file name of the Star-CD files
+     *    \param verbose Tlag to set whether information should be printed
+     *    \param numThreads Number of threads used for parsing, 0 selects
+     *                      the number of hardware threads
+     *    \param minChunkSize Minimal number of bytes of a file parsed by one
+     *                        thread, smaller files are parsed by fewer threads
+     */
+    static void read(GridFactory<GridType>& factory, const std::string& fileName,
+                     bool verbose = true, unsigned int numThreads = 0,
+                     std::size_t minChunkSize = Impl::StarCDFile::defaultMinChunkSize)
+    {
       // currently only dim = 3 is implemented
       if (dim != 3)
         DUNE_THROW(Dune::NotImplemented,
                    "Reading Star-CD format is not implemented for dimension " << dim);
 
-      // set up the grid factory
-      GridFactory<GridType> factory;
-
-      // set the name of the vertex file
-      std::string vertexFileName = fileName + ".vrt";
-
-      // set the vertex input stream
-      std::ifstream vertexFile(vertexFileName.c_str());
-      if (!vertexFile)
-        DUNE_THROW(Dune::IOError, "Could not open " << vertexFileName);
+      if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
 
       // read the vertices
-      int dummyIdx;
-      int numberOfVertices = 0;
-      while (vertexFile >> dummyIdx) {
-        numberOfVertices++;
+      std::vector<std::vector<ctype> > vertexChunks;
+      {
+        const Impl::StarCDFile vertexFile(fileName + ".vrt", numThreads, minChunkSize);
+        vertexChunks = vertexFile.parse<std::vector<ctype> >(parseVertices);
+      }
 
-        Dune::FieldVector<double,dim> position;
+      int numberOfVertices = 0;
+      for (std::vector<ctype>& chunk : vertexChunks)
+      {
+        factory.insertVertices(chunk);
+        numberOfVertices += chunk.size() / dim;
+        std::vector<ctype>().swap(chunk);
+      }
+      if (verbose)
+        std::cout << numberOfVertices << " vertices read." << std::endl;
 
-        for (int k = 0; k < dim; k++)
-          vertexFile >> position[k];
+      // read the elements
+      std::vector<Elements> elementChunks;
+      {
+        const Impl::StarCDFile elementFile(fileName + ".cel", numThreads, minChunkSize);
+        elementChunks = elementFile.parse<Elements>(parseElements);
+      }
 
-        factory.insertVertex(position);
+      int counts[4] = {0, 0, 0, 0};
+      for (Elements& chunk : elementChunks)
+      {
+        factory.insertElements(chunk.types, chunk.offsets, chunk.vertices);
+        for (int k = 0; k < 4; ++k)
+          counts[k] += chunk.counts[k];
+        chunk = Elements();
       }
       if (verbose)
-        std::cout << numberOfVertices << " vertices read." << std::endl;
+        std::cout << counts[0] + counts[1] + counts[2] + counts[3] << " elements read: "
+                  << counts[0] << " simplices, " << counts[1] << " pyramids, "
+                  << counts[2] << " prisms, " << counts[3] << " cubes." << std::endl;
+    }
 
-      // set the name of the element file
-      std::string elementFileName = fileName + ".cel";
+  private:
 
-      // set the element input stream
-      std::ifstream elementFile(elementFileName.c_str());
-      if (!elementFile)
-        DUNE_THROW(Dune::IOError, "Could not open " << elementFileName);
+    // parse the lines of a vertex file
+    static void parseVertices (const char* p, const char* end, std::vector<ctype>& coordinates)
+    {
+      while (Impl::StarCDFile::skipWhitespace(p, end))
+      {
+        Impl::StarCDFile::readInteger(p, end);
+        for (int k = 0; k < dim; k++)
+          coordinates.push_back(Impl::StarCDFile::readDouble(p, end));
+      }
+    }
 
-      // read the elements
-      int numberOfElements = 0;
-      int numberOfSimplices = 0;
-      int numberOfPyramids = 0;
-      int numberOfPrisms = 0;
-      int numberOfCubes = 0;;
-      int maxNumberOfVertices = (int)pow(2, dim);
-      int isVolume = 1;
-      while (elementFile >> dummyIdx) {
-        std::vector<unsigned int> vertices(maxNumberOfVertices);
-        for (int k = 0; k < maxNumberOfVertices; k++)
-          elementFile >> vertices[k];
-
-        int boundaryId;
-        elementFile >> boundaryId;
-
-        int volumeOrSurface[2];
-        elementFile >> volumeOrSurface[0] >> volumeOrSurface[1];
-
-        if (volumeOrSurface[0] == isVolume) {
-          numberOfElements++;
-
-          if (vertices[2] == vertices[3]) {           // simplex or prism
-            if (vertices[4] == vertices[5]) {             // simplex
-              numberOfSimplices++;
-              std::vector<unsigned int> simplexVertices(4);
-              for (int k = 0; k < 3; k++)
-                simplexVertices[k] = vertices[k] - 1;
-              simplexVertices[3] = vertices[4] - 1;
-              factory.insertElement(Dune::GeometryType(Dune::GeometryType::simplex,dim), simplexVertices);
-            }
-            else {             // prism
-              numberOfPrisms++;
-              std::vector<unsigned int> prismVertices(6);
-              for (int k = 0; k < 3; k++)
-                prismVertices[k] = vertices[k] - 1;
-              for (int k = 3; k < 6; k++)
-                prismVertices[k] = vertices[k+1] - 1;
-              factory.insertElement(Dune::GeometryType(Dune::GeometryType::prism,dim), prismVertices);
-            }
+    // parse the lines of an element file and keep the volume elements
+    static void parseElements (const char* p, const char* end, Elements& elements)
+    {
+      const int isVolume = 1;
+      const GeometryType simplex(GeometryType::simplex, dim), pyramid(GeometryType::pyramid, dim);
+      const GeometryType prism(GeometryType::prism, dim), cube(GeometryType::cube, dim);
+      unsigned int v[8];
+      while (Impl::StarCDFile::skipWhitespace(p, end))
+      {
+        Impl::StarCDFile::readInteger(p, end);
+        for (int k = 0; k < 8; k++)
+          v[k] = Impl::StarCDFile::readInteger(p, end) - 1;
+
+        // boundary id and flags
+        Impl::StarCDFile::readInteger(p, end);
+        const long volumeOrSurface = Impl::StarCDFile::readInteger(p, end);
+        Impl::StarCDFile::readInteger(p, end);
+
+        if (volumeOrSurface != isVolume)
+          continue;
+
+        if (v[2] == v[3]) {           // simplex or prism
+          if (v[4] == v[5]) {             // simplex
+            ++elements.counts[0];
+            elements.types.push_back(simplex);
+            elements.vertices.insert(elements.vertices.end(), {v[0], v[1], v[2], v[4]});
           }
-          else {           // cube or pyramid
-            if (vertices[4] == vertices[5]) {             // pyramid
-              numberOfPyramids++;
-              std::vector<unsigned int> pyramidVertices(5);
-              for (int k = 0; k < 5; k++)
-                pyramidVertices[k] = vertices[k] - 1;
-              factory.insertElement(Dune::GeometryType(Dune::GeometryType::pyramid,dim), pyramidVertices);
-            }
-            else {             // cube
-              numberOfCubes++;
-              std::vector<unsigned int> cubeVertices(8);
-              for (int k = 0; k < 8; k++)
-                cubeVertices[k] = vertices[k] - 1;
-              std::swap(cubeVertices[2], cubeVertices[3]);
-              std::swap(cubeVertices[6], cubeVertices[7]);
-              factory.insertElement(Dune::GeometryType(Dune::GeometryType::cube,dim), cubeVertices);
-            }
+          else {             // prism
+            ++elements.counts[2];
+            elements.types.push_back(prism);
+            elements.vertices.insert(elements.vertices.end(), {v[0], v[1], v[2], v[4], v[5], v[6]});
           }
         }
+        else {           // cube or pyramid
+          if (v[4] == v[5]) {             // pyramid
+            ++elements.counts[1];
+            elements.types.push_back(pyramid);
+            elements.vertices.insert(elements.vertices.end(), {v[0], v[1], v[2], v[3], v[4]});
+          }
+          else {             // cube
+            ++elements.counts[3];
+            elements.types.push_back(cube);
+            elements.vertices.insert(elements.vertices.end(), {v[0], v[1], v[3], v[2], v[4], v[5], v[7], v[6]});
+          }
+        }
+        elements.offsets.push_back(elements.vertices.size());
       }
-      if (verbose)
-        std::cout << numberOfElements << " elements read: "
-                  << numberOfSimplices << " simplices, " << numberOfPyramids << " pyramids, "
-                  << numberOfPrisms << " prisms, " << numberOfCubes << " cubes." << std::endl;
-
-      // finish off the construction of the grid object
-      if (verbose)
-        std::cout << "Starting createGrid() ... " << std::flush;
-
-      return factory.createGrid();
-
     }
 
   };
@@ -0,0 +1,160 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include <config.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/io/file/gmshreader.hh>
+
+/** \file
+ * \brief Measure the time the GmshReader needs for large files
+ *
+ * A one-dimensional mesh with the given number of elements (default 100000)
+ * is written in different Gmsh formats and read back into a OneDGrid.
+ * The reported times cover the parsing and the insertion into the grid
+ * factory, but not the construction of the grid. Call e.g.
+ *
+ *   ./gmshreaderbenchmark 10000000
+ *
+ * to measure a mesh with 10M elements.
+ */
+
+using namespace Dune;
+
+enum class Format { ascii2, ascii4, binary4 };
+
+// write a 1d mesh on [0,1] with n elements, the node tags are 1 + tagStride*i
+void writeMesh (const std::string& fileName, long long n, Format format, long long tagStride)
+{
+  FILE* file = std::fopen(fileName.c_str(), "wb");
+  if (file == 0)
+    DUNE_THROW(IOError, "Could not open " << fileName);
+
+  const double h = 1.0/n;
+  auto tag = [&] (long long i) { return 1 + tagStride*i; };
+
+  if (format == Format::ascii2)
+  {
+    std::fprintf(file, "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n");
+    std::fprintf(file, "$Nodes\n%lld\n", n+1);
+    for (long long i = 0; i <= n; ++i)
+      std::fprintf(file, "%lld %.17g 0 0\n", tag(i), i*h);
+    std::fprintf(file, "$EndNodes\n$Elements\n%lld\n", n);
+    for (long long i = 0; i < n; ++i)
+      std::fprintf(file, "%lld 1 2 0 1 %lld %lld\n", i+1, tag(i), tag(i+1));
+    std::fprintf(file, "$EndElements\n");
+  }
+  else
+  {
+    const bool binary = (format == Format::binary4);
+
+    // write the values of a line, either in ASCII or in binary
+    auto sizes = [&] (std::initializer_list<std::size_t> values) {
+      if (binary)
+        for (std::size_t v : values)
+          std::fwrite(&v, sizeof(v), 1, file);
+      else
+      {
+        for (std::size_t v : values)
+          std::fprintf(file, "%zu ", v);
+        std::fprintf(file, "\n");
+      }
+    };
+    auto block = [&] (int entityDim, int entityTag, int type, std::size_t count) {
+      if (binary)
+      {
+        const int header[3] = {entityDim, entityTag, type};
+        std::fwrite(header, sizeof(int), 3, file);
+        std::fwrite(&count, sizeof(count), 1, file);
+      }
+      else
+        std::fprintf(file, "%d %d %d %zu\n", entityDim, entityTag, type, count);
+    };
+
+    std::fprintf(file, "$MeshFormat\n4.1 %d %d\n", binary ? 1 : 0, int(sizeof(std::size_t)));
+    if (binary)
+    {
+      const int one = 1;
+      std::fwrite(&one, sizeof(int), 1, file);
+      std::fprintf(file, "\n");
+    }
+    std::fprintf(file, "$EndMeshFormat\n");
+
+    std::fprintf(file, "$Nodes\n");
+    sizes({1, std::size_t(n+1), std::size_t(tag(0)), std::size_t(tag(n))});
+    block(1, 1, 0, n+1);
+    for (long long i = 0; i <= n; ++i)
+      sizes({std::size_t(tag(i))});
+    for (long long i = 0; i <= n; ++i)
+    {
+      const double x[3] = {i*h, 0.0, 0.0};
+      if (binary)
+        std::fwrite(x, sizeof(double), 3, file);
+      else
+        std::fprintf(file, "%.17g 0 0\n", x[0]);
+    }
+    std::fprintf(file, "%s$EndNodes\n", binary ? "\n" : "");
+
+    std::fprintf(file, "$Elements\n");
+    sizes({1, std::size_t(n), 1, std::size_t(n)});
+    block(1, 1, 1, n);
+    for (long long i = 0; i < n; ++i)
+      sizes({std::size_t(i+1), std::size_t(tag(i)), std::size_t(tag(i+1))});
+    std::fprintf(file, "%s$EndElements\n", binary ? "\n" : "");
+  }
+
+  std::fclose(file);
+}
+
+void benchmark (const std::string& name, long long n, Format format, long long tagStride)
+{
+  const std::string fileName = "gmshreaderbenchmark-" + name + ".msh";
+  writeMesh(fileName, n, format, tagStride);
+
+  Timer watch;
+  GridFactory<OneDGrid> factory;
+  GmshReader<OneDGrid>::read(factory, fileName, false, false);
+  const double readTime = watch.elapsed();
+
+  std::unique_ptr<OneDGrid> grid(factory.createGrid());
+  if (grid->leafGridView().size(0) != n || grid->leafGridView().size(1) != n+1)
+    DUNE_THROW(GridError, "Grid read from " << fileName << " has " << grid->leafGridView().size(0)
+               << " elements and " << grid->leafGridView().size(1) << " vertices instead of "
+               << n << " and " << n+1);
+
+  std::cout << "  " << name << ": " << readTime << " s" << std::endl;
+  std::remove(fileName.c_str());
+}
+
+int main (int argc, char** argv)
+try
+{
+  MPIHelper::instance(argc, argv);
+  const long long n = (argc > 1) ? std::atoll(argv[1]) : 100000;
+
+  std::cout << "Reading a Gmsh file with " << n << " elements:" << std::endl;
+  benchmark("ascii-v2", n, Format::ascii2, 1);
+  benchmark("ascii-v4", n, Format::ascii4, 1);
+  benchmark("binary-v4", n, Format::binary4, 1);
+  // node tags too sparse to be used as indices
+  benchmark("binary-v4-sparse", n, Format::binary4, 97);
+
+  return 0;
+}
+catch (Dune::Exception &e)
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
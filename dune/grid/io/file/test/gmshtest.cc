@@ -4,10 +4,12 @@
 #include "config.h"
 #define DISABLE_DEPRECATED_METHOD_CHECK 1
 
+#include <array>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <dune/common/parallel/mpihelper.hh>
@@ -95,6 +97,27 @@ void testReadingAndWritingGrid( const std::string& path, const std::string& grid
     writer.write(outputNameBoundary,elementsIDs,boundaryIDs);
   }
 
+  // Write MSH in the other formats, with data, and read it back
+  std::vector<double> vertexData(leafGridView.size(GridType::dimension), 1.0);
+  std::vector<double> elementData(3*leafGridView.size(0), 2.0);
+  writer.addNodeData(vertexData, "vertexData");
+  writer.addElementData(elementData, "elementData", 3);
+  const std::array<std::pair<GmshWriterOptions::FileFormat,std::string>,4> formats = {{
+    {GmshWriterOptions::ascii, "ascii"}, {GmshWriterOptions::binary, "binary"},
+    {GmshWriterOptions::ascii4, "ascii4"}, {GmshWriterOptions::binary4, "binary4"}}};
+  for (const auto& format : formats)
+  {
+    writer.setFormat(format.first);
+    const std::string outputNameFormat("./"+gridName+"-"+gridManagerName+"-gmshtest-write-"+format.second+".msh");
+    writer.write(outputNameFormat);
+    auto writtenGrid=std::unique_ptr<GridType>(GmshReader<GridType>::read(outputNameFormat,false,false));
+    if (writtenGrid->leafGridView().size(0) != leafGridView.size(0))
+      DUNE_THROW(GridError, "Grid written to " << outputNameFormat << " has " << writtenGrid->leafGridView().size(0)
+                 << " elements instead of " << leafGridView.size(0));
+  }
+  writer.clear();
+  writer.setFormat(GmshWriterOptions::ascii);
+
   // Write VTK
   std::ostringstream vtkName;
   vtkName << "./" << gridName << "-gmshtest-" << refinements;
@@ -103,6 +126,40 @@ void testReadingAndWritingGrid( const std::string& path, const std::string& grid
   std::cout<<std::endl;
 }
 
+template <typename GridType>
+void testReadingSlices( const std::string& path, const std::string& gridName, int numberOfSlices )
+{
+  // Read the whole grid
+  const std::string inputName(path+gridName+".msh");
+  std::cout<<"Reading mesh file "<<inputName<<" in "<<numberOfSlices<<" slices"<<std::endl;
+  std::vector<int> boundaryIDs;
+  std::vector<int> elementsIDs;
+  auto grid=std::unique_ptr<GridType>(GmshReader<GridType>::read(inputName,boundaryIDs,elementsIDs,false,false));
+
+  // Read the slices, together they have to contain each element exactly once
+  int numberOfElements = 0;
+  std::vector<int> sliceElementsIDs;
+  for (int slice = 0; slice < numberOfSlices; ++slice)
+  {
+    GridFactory<GridType> gridFactory;
+    std::vector<int> sliceBoundaryIDs;
+    std::vector<int> elementsIDsOfSlice;
+    GmshReader<GridType>::readSlice(gridFactory,inputName,slice,numberOfSlices,sliceBoundaryIDs,elementsIDsOfSlice,false,false);
+    auto sliceGrid=std::unique_ptr<GridType>(gridFactory.createGrid());
+    gridcheck(*sliceGrid);
+
+    numberOfElements += sliceGrid->leafGridView().size(0);
+    sliceElementsIDs.insert(sliceElementsIDs.end(), elementsIDsOfSlice.begin(), elementsIDsOfSlice.end());
+  }
+
+  if (numberOfElements != grid->leafGridView().size(0))
+    DUNE_THROW(GridError, "The slices of " << inputName << " contain " << numberOfElements
+               << " elements instead of " << grid->leafGridView().size(0));
+  if (sliceElementsIDs != elementsIDs)
+    DUNE_THROW(GridError, "The slices of " << inputName << " have different physical entities than the grid");
+  std::cout<<std::endl;
+}
+
 
 int main( int argc, char** argv )
 try
@@ -116,6 +173,8 @@ try
   testReadingAndWritingGrid<UGGrid<2> >( path, "circle2ndorder", "UGGrid-2D", refinements );
   testReadingAndWritingGrid<UGGrid<2> >( path, "unitsquare_quads_2x2", "UGGrid-2D", refinements );
   testReadingAndWritingGrid<UGGrid<2> >( path, "hybrid-testgrid-2d", "UGGrid-2D", refinements );
+  testReadingAndWritingGrid<UGGrid<2> >( path, "hybrid-testgrid-2d-binary", "UGGrid-2D", refinements );
+  testReadingAndWritingGrid<UGGrid<2> >( path, "hybrid-testgrid-2d-v41", "UGGrid-2D", refinements );
   testReadingAndWritingGrid<UGGrid<3> >( path, "pyramid", "UGGrid-3D", refinements );
   testReadingAndWritingGrid<UGGrid<3> >( path, "pyramid2ndorder", "UGGrid-3D", refinements );
   testReadingAndWritingGrid<UGGrid<3> >( path, "hybrid-testgrid-3d", "UGGrid-3D", refinements );
@@ -133,6 +192,11 @@ try
 
 #if GMSH_ONEDGRID
   testReadingAndWritingGrid<OneDGrid>( path, "oned-testgrid", "OneDGrid", refinements );
+  testReadingAndWritingGrid<OneDGrid>( path, "oned-testgrid-binary", "OneDGrid", refinements );
+  testReadingAndWritingGrid<OneDGrid>( path, "oned-testgrid-v41", "OneDGrid", refinements );
+  testReadingAndWritingGrid<OneDGrid>( path, "oned-testgrid-v41-binary", "OneDGrid", refinements );
+  testReadingSlices<OneDGrid>( path, "oned-testgrid", 3 );
+  testReadingSlices<OneDGrid>( path, "oned-testgrid-v41-binary", 3 );
 #endif
 
   return 0;
@@ -0,0 +1,163 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include <config.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/io/file/starcdreader.hh>
+
+/** \file
+ * \brief Measure the time the StarCDReader needs for large files
+ *
+ * A structured hexahedral mesh of the unit cube with n^3 cells (default
+ * n = 40) is written in the Star-CD format and read into the grid factory
+ * of a UGGrid, using one thread and the given number of threads (default:
+ * all hardware threads). The reported times cover the parsing and the
+ * insertion into the grid factory, but not the construction of the grid.
+ * Call e.g.
+ *
+ *   ./starcdreaderbenchmark 272 8
+ *
+ * to measure a mesh with 20M cells with 8 threads.
+ *
+ * Independent of the size of the benchmark mesh, a small mesh is read with
+ * one thread and split into many chunks read by several threads. Both grids
+ * have to be identical.
+ */
+
+using namespace Dune;
+
+// write the Star-CD files of a mesh of the unit cube with n^3 hexahedra
+void writeMesh (const std::string& baseName, long long n)
+{
+  const std::string vertexFileName = baseName + ".vrt";
+  FILE* file = std::fopen(vertexFileName.c_str(), "wb");
+  if (file == 0)
+    DUNE_THROW(IOError, "Could not open " << vertexFileName);
+
+  const double h = 1.0/n;
+  long long idx = 0;
+  for (long long k = 0; k <= n; ++k)
+    for (long long j = 0; j <= n; ++j)
+      for (long long i = 0; i <= n; ++i)
+        std::fprintf(file, "%9lld %.16E %.16E %.16E\n", ++idx, i*h, j*h, k*h);
+  std::fclose(file);
+
+  const std::string elementFileName = baseName + ".cel";
+  file = std::fopen(elementFileName.c_str(), "wb");
+  if (file == 0)
+    DUNE_THROW(IOError, "Could not open " << elementFileName);
+
+  // Star-CD numbers the corners of the faces cyclically
+  auto vertex = [n] (long long i, long long j, long long k) { return 1 + i + (n+1)*(j + (n+1)*k); };
+  idx = 0;
+  for (long long k = 0; k < n; ++k)
+    for (long long j = 0; j < n; ++j)
+      for (long long i = 0; i < n; ++i)
+        std::fprintf(file, "%9lld %9lld %9lld %9lld %9lld %9lld %9lld %9lld %9lld %4d %4d %4d\n", ++idx,
+                     vertex(i, j, k), vertex(i+1, j, k), vertex(i+1, j+1, k), vertex(i, j+1, k),
+                     vertex(i, j, k+1), vertex(i+1, j, k+1), vertex(i+1, j+1, k+1), vertex(i, j+1, k+1),
+                     1, 1, 1);
+  std::fclose(file);
+}
+
+void benchmark (const std::string& baseName, long long n, unsigned int numThreads)
+{
+  Timer watch;
+  GridFactory<UGGrid<3> > factory;
+  StarCDReader<UGGrid<3> >::read(factory, baseName, false, numThreads);
+  const double readTime = watch.elapsed();
+
+  std::cout << "  " << numThreads << " thread(s): " << readTime << " s" << std::endl;
+
+  if (n <= 20)
+  {
+    std::unique_ptr<UGGrid<3> > grid(factory.createGrid());
+    if (grid->leafGridView().size(0) != n*n*n || grid->leafGridView().size(3) != (n+1)*(n+1)*(n+1))
+      DUNE_THROW(GridError, "Grid read from " << baseName << " has " << grid->leafGridView().size(0)
+                 << " elements and " << grid->leafGridView().size(3) << " vertices instead of "
+                 << n*n*n << " and " << (n+1)*(n+1)*(n+1));
+  }
+}
+
+// read a small mesh into one chunk and into many chunks and compare the grids
+void checkSplit (const std::string& baseName)
+{
+  const long long n = 8;
+  writeMesh(baseName, n);
+
+  GridFactory<UGGrid<3> > serialFactory;
+  StarCDReader<UGGrid<3> >::read(serialFactory, baseName, false, 1);
+  std::unique_ptr<UGGrid<3> > serialGrid(serialFactory.createGrid());
+
+  // a minimal chunk size of one byte splits the files for every thread
+  GridFactory<UGGrid<3> > splitFactory;
+  StarCDReader<UGGrid<3> >::read(splitFactory, baseName, false, 7, 1);
+  std::unique_ptr<UGGrid<3> > splitGrid(splitFactory.createGrid());
+
+  std::remove((baseName + ".vrt").c_str());
+  std::remove((baseName + ".cel").c_str());
+
+  const auto serialView = serialGrid->leafGridView();
+  const auto splitView = splitGrid->leafGridView();
+  if (serialView.size(0) != n*n*n || splitView.size(0) != n*n*n || serialView.size(3) != splitView.size(3))
+    DUNE_THROW(GridError, "Split read of " << baseName << " has " << splitView.size(0) << " elements and "
+               << splitView.size(3) << " vertices instead of " << serialView.size(0) << " and " << serialView.size(3));
+
+  auto splitElement = elements(splitView).begin();
+  for (const auto& serialElement : elements(serialView))
+  {
+    const auto& element = *splitElement;
+    ++splitElement;
+    if (serialFactory.insertionIndex(serialElement) != splitFactory.insertionIndex(element)
+        || serialElement.type() != element.type())
+      DUNE_THROW(GridError, "Split read of " << baseName << " yields different elements");
+    for (unsigned int i = 0; i < serialElement.subEntities(3); ++i)
+    {
+      const auto serialVertex = serialElement.subEntity<3>(i);
+      const auto vertex = element.subEntity<3>(i);
+      if (serialFactory.insertionIndex(serialVertex) != splitFactory.insertionIndex(vertex)
+          || serialVertex.geometry().corner(0) != vertex.geometry().corner(0))
+        DUNE_THROW(GridError, "Split read of " << baseName << " yields different vertices");
+    }
+  }
+}
+
+int main (int argc, char** argv)
+try
+{
+  MPIHelper::instance(argc, argv);
+  const long long n = (argc > 1) ? std::atoll(argv[1]) : 40;
+  const unsigned int numThreads = (argc > 2) ? std::atoi(argv[2]) : std::thread::hardware_concurrency();
+
+  const std::string baseName = "starcdreaderbenchmark";
+  checkSplit(baseName);
+
+  writeMesh(baseName, n);
+
+  std::cout << "Reading a Star-CD mesh with " << n*n*n << " cells:" << std::endl;
+  benchmark(baseName, n, 1);
+  if (numThreads > 1)
+    benchmark(baseName, n, numThreads);
+
+  std::remove((baseName + ".vrt").c_str());
+  std::remove((baseName + ".cel").c_str());
+  return 0;
+}
+catch (Dune::Exception &e)
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
@@ -460,6 +460,7 @@ namespace Dune {
 // GridFactory<OneDGrid> can be defined.  This is why the #include-
 // directive is at _the end_ of this file.
 #include <dune/grid/onedgrid/onedgridfactory.hh>
+#include <dune/grid/onedgrid/onedgridpersistentcontainer.hh>
 
 
 #endif
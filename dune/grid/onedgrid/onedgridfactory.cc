@@ -57,6 +57,47 @@ insertElement(const GeometryType& type,
   elements_.back()[1] = vertices[1];
 }
 
+void Dune::GridFactory<Dune::OneDGrid>::
+insertVertices(const std::vector<ctype>& coordinates)
+{
+  // the hint makes the insertion of sorted coordinates take constant time
+  for (ctype x : coordinates)
+    vertexPositions_.emplace_hint(vertexPositions_.end(), FieldVector<ctype,1>(x), vertexIndex_++);
+}
+
+void Dune::GridFactory<Dune::OneDGrid>::
+insertElements(const GeometryType& type,
+               const std::vector<unsigned int>& vertices)
+{
+  if (type.dim() != 1)
+    DUNE_THROW(GridError, "You cannot insert a " << type << " into a OneDGrid!");
+
+  if (vertices.size() % 2 != 0)
+    DUNE_THROW(GridError, "You cannot insert elements with " << vertices.size() << " vertices in total into a OneDGrid!");
+
+  elements_.reserve(elements_.size() + vertices.size()/2);
+  for (std::size_t i=0; i<vertices.size(); i+=2)
+    elements_.push_back({{vertices[i], vertices[i+1]}});
+}
+
+void Dune::GridFactory<Dune::OneDGrid>::
+insertElements(const std::vector<GeometryType>& types,
+               const std::vector<unsigned int>& offsets,
+               const std::vector<unsigned int>& vertices)
+{
+  checkOffsets(types, offsets, vertices);
+
+  for (std::size_t i=0; i<types.size(); i++)
+  {
+    if (types[i].dim() != 1)
+      DUNE_THROW(GridError, "You cannot insert a " << types[i] << " into a OneDGrid!");
+    if (offsets[i+1] - offsets[i] != 2)
+      DUNE_THROW(GridError, "You cannot insert an element with " << offsets[i+1] - offsets[i] << " vertices into a OneDGrid!");
+  }
+
+  insertElements(GeometryType(GeometryType::cube, 1), vertices);
+}
+
 void Dune::GridFactory<Dune::OneDGrid>::
 insertBoundarySegment(const std::vector<unsigned int>& vertices)
 {
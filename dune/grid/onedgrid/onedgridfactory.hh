@@ -62,6 +62,29 @@ namespace Dune {
     virtual void insertElement(const GeometryType& type,
                                const std::vector<unsigned int>& vertices);
 
+    /** \brief Insert several vertices into the coarse grid
+        \param coordinates The coordinates of the vertices
+
+        Sorted coordinates are inserted in linear time.
+     */
+    virtual void insertVertices(const std::vector<ctype>& coordinates);
+
+    /** \brief Insert several elements into the coarse grid
+        \param type The GeometryType of the new elements
+        \param vertices The two vertices of each element
+     */
+    virtual void insertElements(const GeometryType& type,
+                                const std::vector<unsigned int>& vertices);
+
+    /** \brief Insert several elements into the coarse grid
+        \param types The GeometryTypes of the new elements
+        \param offsets Offsets of the vertices of each element (CSR format)
+        \param vertices The vertices of the new elements
+     */
+    virtual void insertElements(const std::vector<GeometryType>& types,
+                                const std::vector<unsigned int>& offsets,
+                                const std::vector<unsigned int>& vertices);
+
     /** \brief Insert a boundary segment (== a point).
         This influences the ordering of the boundary segments
      */
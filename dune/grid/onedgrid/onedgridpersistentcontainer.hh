@@ -0,0 +1,46 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ONEDGRID_PERSISTENTCONTAINER_HH
+#define DUNE_ONEDGRID_PERSISTENTCONTAINER_HH
+
+/** \file
+ * \brief Specialization of the PersistentContainer for OneDGrid
+ */
+
+#include <unordered_map>
+
+#include <dune/grid/utility/persistentcontainer.hh>
+#include "../onedgrid.hh"
+
+namespace Dune
+{
+
+  /** \brief Specialization of the PersistentContainer for OneDGrid
+   *
+   *  The ids of OneDGrid are unsigned integers that are never reused.  They
+   *  are hashed instead of sorted, so accessing the data of an entity takes
+   *  constant instead of logarithmic time.
+   *
+   *  std::unordered_map is used rather than a table with open addressing:
+   *  the ids are counters, and the common standard libraries hash integers to
+   *  themselves, so entities created together stay close in memory.  On
+   *  large grids this outweighs the allocation per node.
+   */
+  template< class T >
+  class PersistentContainer< OneDGrid, T >
+    : public PersistentContainerMap< OneDGrid, OneDGrid::LocalIdSet, std::unordered_map< OneDGrid::LocalIdSet::IdType, T > >
+  {
+    typedef PersistentContainerMap< OneDGrid, OneDGrid::LocalIdSet, std::unordered_map< OneDGrid::LocalIdSet::IdType, T > > Base;
+
+  public:
+    typedef typename Base::Grid Grid;
+    typedef typename Base::Value Value;
+
+    PersistentContainer ( const Grid &grid, int codim, const Value &value = Value() )
+      : Base( grid, codim, grid.localIdSet(), value )
+    {}
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_ONEDGRID_PERSISTENTCONTAINER_HH
@@ -4,7 +4,9 @@
 #ifndef DUNE_GRID_TEST_CHECKGEOMETRY_HH
 #define DUNE_GRID_TEST_CHECKGEOMETRY_HH
 
+#include <cmath>
 #include <limits>
+#include <vector>
 
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/std/utility.hh>
@@ -12,6 +14,7 @@
 
 #include <dune/geometry/test/checkgeometry.hh>
 
+#include <dune/grid/common/exceptions.hh>
 #include <dune/grid/common/geometry.hh>
 #include <dune/grid/common/entity.hh>
 #include <dune/grid/common/gridview.hh>
@@ -157,6 +160,39 @@ namespace Dune
     }
   }
 
+  /** \brief check that the batched global/local evaluation matches the pointwise one
+   *
+   *  The points used are the corners of the reference element and its center.
+   */
+  template< int mydim, int cdim, class Grid, template< int, int, class > class Imp >
+  void checkGeometryBatch ( const Geometry< mydim, cdim, Grid, Imp > &geometry )
+  {
+    typedef Geometry< mydim, cdim, Grid, Imp > Geo;
+    typedef typename Geo::ctype ctype;
+
+    const auto& refElement = ReferenceElements< ctype, mydim >::general( geometry.type() );
+
+    std::vector< typename Geo::LocalCoordinate > local;
+    for( int i = 0; i < refElement.size( mydim ); ++i )
+      local.push_back( refElement.position( i, mydim ) );
+    local.push_back( refElement.position( 0, 0 ) );
+
+    std::vector< typename Geo::GlobalCoordinate > global( local.size() );
+    geometry.global( local, global );
+
+    std::vector< typename Geo::LocalCoordinate > localAgain( local.size() );
+    geometry.local( global, localAgain );
+
+    const ctype tolerance = std::sqrt( std::numeric_limits< ctype >::epsilon() );
+    for( std::size_t q = 0; q < local.size(); ++q )
+    {
+      if( (global[ q ] - geometry.global( local[ q ] )).two_norm() > tolerance )
+        DUNE_THROW( GridError, "Batched global() differs from pointwise global() at " << local[ q ] << "." );
+      if( (localAgain[ q ] - geometry.local( global[ q ] )).two_norm() > tolerance )
+        DUNE_THROW( GridError, "Batched local() differs from pointwise local() at " << global[ q ] << "." );
+    }
+  }
+
   template<class Grid>
   struct GeometryChecker
   {
@@ -170,7 +206,10 @@ namespace Dune
       const auto end = gridView.template end<0>();
       auto it = gridView.template begin<0>();
       for( ; it != end; ++it )
+      {
         Hybrid::forEach(Std::make_index_sequence<GridView<VT>::dimension+1>{},[&](auto i){SubEntityGeometryChecker<i>::apply(*it);});
+        checkGeometryBatch( it->geometry() );
+      }
     }
   };
 
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <dune/common/exceptions.hh>
@@ -102,6 +103,196 @@ namespace Dune
     checkGridFactory< Grid >( mesh, [] ( const typename Mesh::Vertex &v ) { return v; } );
   }
 
+
+
+  // DefaultBulkInsertionFactory
+  // ---------------------------
+
+  /** \brief grid factory forwarding the insertion of single items to GridFactory< Grid >
+   *
+   *  The bulk insertion methods are not overridden, so that this factory
+   *  exercises the default implementations of GridFactoryInterface.
+   */
+  template< class Grid >
+  class DefaultBulkInsertionFactory
+    : public GridFactoryInterface< Grid >
+  {
+    typedef FieldVector< typename Grid::ctype, Grid::dimensionworld > Vertex;
+
+  public:
+    virtual void insertVertex ( const Vertex &pos ) { factory_.insertVertex( pos ); }
+
+    virtual void insertElement ( const GeometryType &type, const std::vector< unsigned int > &vertices )
+    {
+      factory_.insertElement( type, vertices );
+    }
+
+    virtual void insertBoundarySegment ( const std::vector< unsigned int > &vertices )
+    {
+      factory_.insertBoundarySegment( vertices );
+    }
+
+    virtual Grid *createGrid () { return factory_.createGrid(); }
+
+    virtual unsigned int insertionIndex ( const typename Grid::template Codim< 0 >::Entity &entity ) const
+    {
+      return factory_.insertionIndex( entity );
+    }
+
+    virtual unsigned int insertionIndex ( const typename Grid::template Codim< Grid::dimension >::Entity &entity ) const
+    {
+      return factory_.insertionIndex( entity );
+    }
+
+  private:
+    GridFactory< Grid > factory_;
+  };
+
+
+
+  // checkBulkInsertion
+  // ------------------
+
+  // compare the macro grids created by inserting the same mesh in two different ways
+  template< class Grid, class Factory >
+  void compareBulkInsertion ( const Grid &grid, const Factory &factory, const Grid &reference, const Factory &referenceFactory,
+                              bool checkInsertionIndices, const std::string &method )
+  {
+    const auto gridView = grid.levelGridView( 0 );
+    const auto referenceView = reference.levelGridView( 0 );
+    if( (gridView.size( 0 ) != referenceView.size( 0 )) || (gridView.size( Grid::dimension ) != referenceView.size( Grid::dimension )) )
+      DUNE_THROW( GridError, "GridFactory error, " << method << " yields a grid of different size!" );
+
+    auto referenceIt = elements( referenceView ).begin();
+    for( const auto &element : elements( gridView ) )
+    {
+      const auto &referenceElement = *referenceIt;
+      ++referenceIt;
+
+      if( (element.type() != referenceElement.type())
+          || (gridView.indexSet().index( element ) != referenceView.indexSet().index( referenceElement )) )
+        DUNE_THROW( GridError, "GridFactory error, " << method << " yields different elements!" );
+      if( checkInsertionIndices && (factory.insertionIndex( element ) != referenceFactory.insertionIndex( referenceElement )) )
+        DUNE_THROW( GridError, "GridFactory error, " << method << " yields different element insertion indices!" );
+
+      for( unsigned int i = 0; i < element.subEntities( Grid::dimension ); ++i )
+      {
+        const auto vertex = element.template subEntity< Grid::dimension >( i );
+        const auto referenceVertex = referenceElement.template subEntity< Grid::dimension >( i );
+        if( (gridView.indexSet().index( vertex ) != referenceView.indexSet().index( referenceVertex ))
+            || ((vertex.geometry().corner( 0 ) - referenceVertex.geometry().corner( 0 )).two_norm() > 1e-12) )
+          DUNE_THROW( GridError, "GridFactory error, " << method << " yields different vertices!" );
+        if( checkInsertionIndices && (factory.insertionIndex( vertex ) != referenceFactory.insertionIndex( referenceVertex )) )
+          DUNE_THROW( GridError, "GridFactory error, " << method << " yields different vertex insertion indices!" );
+      }
+    }
+  }
+
+
+  template< class Error, class Insert >
+  void checkBulkInsertionError ( Insert &&insert, const std::string &error )
+  {
+    bool thrown = false;
+    try
+    {
+      insert();
+    }
+    catch( const Error & )
+    {
+      thrown = true;
+    }
+    if( !thrown )
+      DUNE_THROW( GridError, "GridFactory error, bulk insertion accepts " << error << "!" );
+  }
+
+
+  /** \brief check insertVertices and insertElements against the insertion of single items
+   *
+   *  The mesh is inserted vertex by vertex and element by element, and in
+   *  bulk. Both macro grids must have the same index sets, geometries and,
+   *  if checkInsertionIndices is set, insertion indices. Invalid bulk input
+   *  has to be rejected.
+   */
+  template< class Grid, class Factory = GridFactory< Grid >, class Mesh >
+  void checkBulkInsertion ( const Mesh &mesh, bool checkInsertionIndices = true )
+  {
+    // the mesh in the flat format of the bulk insertion
+    std::vector< typename Grid::ctype > coordinates;
+    for( const auto &v : mesh.vertices )
+      coordinates.insert( coordinates.end(), v.begin(), v.end() );
+
+    std::vector< GeometryType > types;
+    std::vector< unsigned int > offsets( 1, 0 ), corners;
+    for( const auto &e : mesh.elements )
+    {
+      types.push_back( e.first );
+      corners.insert( corners.end(), e.second.begin(), e.second.end() );
+      offsets.push_back( corners.size() );
+    }
+    const bool singleType = std::all_of( types.begin(), types.end(), [ &types ] ( const GeometryType &type ) { return type == types.front(); } );
+
+    Factory itemFactory;
+    for( const auto &v : mesh.vertices )
+      itemFactory.insertVertex( v );
+    for( const auto &e : mesh.elements )
+      itemFactory.insertElement( e.first, e.second );
+    for( const auto &b : mesh.boundaries )
+      itemFactory.insertBoundarySegment( b );
+    std::unique_ptr< Grid > itemGrid( itemFactory.createGrid() );
+
+    {
+      Factory bulkFactory;
+      bulkFactory.insertVertices( coordinates );
+      bulkFactory.insertElements( types, offsets, corners );
+      for( const auto &b : mesh.boundaries )
+        bulkFactory.insertBoundarySegment( b );
+      std::unique_ptr< Grid > bulkGrid( bulkFactory.createGrid() );
+      compareBulkInsertion( *bulkGrid, bulkFactory, *itemGrid, itemFactory, checkInsertionIndices, "insertElements(types, offsets, vertices)" );
+    }
+
+    if( singleType )
+    {
+      Factory bulkFactory;
+      bulkFactory.insertVertices( coordinates );
+      bulkFactory.insertElements( types.front(), corners );
+      for( const auto &b : mesh.boundaries )
+        bulkFactory.insertBoundarySegment( b );
+      std::unique_ptr< Grid > bulkGrid( bulkFactory.createGrid() );
+      compareBulkInsertion( *bulkGrid, bulkFactory, *itemGrid, itemFactory, checkInsertionIndices, "insertElements(type, vertices)" );
+    }
+
+    // invalid input, the vertex indices do not matter as the sizes are checked first
+    const GeometryType type = mesh.elements.front().first;
+    const unsigned int n = mesh.elements.front().second.size();
+    checkBulkInsertionError< GridError >( [ type, n ] () {
+        Factory factory;
+        factory.insertElements( { type }, { 0 }, std::vector< unsigned int >( n, 0 ) );
+      }, "too few offsets" );
+    checkBulkInsertionError< GridError >( [ type, n ] () {
+        Factory factory;
+        factory.insertElements( { type }, { 1, n }, std::vector< unsigned int >( n, 0 ) );
+      }, "a first offset different from zero" );
+    checkBulkInsertionError< GridError >( [ type, n ] () {
+        Factory factory;
+        factory.insertElements( { type }, { 0, n }, std::vector< unsigned int >( n+1, 0 ) );
+      }, "a last offset different from the number of vertices" );
+    checkBulkInsertionError< GridError >( [ type, n ] () {
+        Factory factory;
+        factory.insertElements( { type, type }, { 0, 2*n+1, 2*n }, std::vector< unsigned int >( 2*n, 0 ) );
+      }, "unsorted offsets" );
+    checkBulkInsertionError< Exception >( [ type, n ] () {
+        Factory factory;
+        factory.insertElements( type, std::vector< unsigned int >( n+1, 0 ) );
+      }, "a number of vertices that is not a multiple of the number of corners" );
+    if( Grid::dimensionworld > 1 )
+    {
+      checkBulkInsertionError< Exception >( [] () {
+          Factory factory;
+          factory.insertVertices( std::vector< typename Grid::ctype >( Grid::dimensionworld+1, 0 ) );
+        }, "a number of coordinates that is not a multiple of the world dimension" );
+    }
+  }
+
 } // namespace Dune
 
 #endif // #ifndef DUNE_GRID_TEST_CHECKGRIDFACTORY_HH
@@ -3,7 +3,10 @@
 #include <config.h>
 
 #include <iostream>
+#include <set>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #ifndef GRIDDIM
 #define GRIDDIM ALBERTA_DIM
@@ -58,6 +61,77 @@ void markOne ( GridType & grid , int num , int ref )
   grid.postAdapt();
 }
 
+// compare the cached sizes of all levels and of the leaf with the entities counted by iteration
+template< class GridView >
+void checkSizes ( const GridView &gridView, const std::string &name )
+{
+  const int dim = GridView::dimension;
+  const auto &idSet = gridView.grid().globalIdSet();
+
+  std::vector< std::set< typename GridView::Grid::GlobalIdSet::IdType > > ids( dim+1 );
+  for( const auto &element : elements( gridView ) )
+  {
+    for( int codim = 0; codim <= dim; ++codim )
+    {
+      for( unsigned int i = 0; i < element.subEntities( codim ); ++i )
+        ids[ codim ].insert( idSet.subId( element, i, codim ) );
+    }
+  }
+
+  for( int codim = 0; codim <= dim; ++codim )
+  {
+    const Dune::GeometryType type( Dune::GeometryType::simplex, dim - codim );
+    if( (gridView.size( codim ) != int( ids[ codim ].size() )) || (gridView.size( type ) != int( ids[ codim ].size() )) )
+      DUNE_THROW( Dune::GridError, "Size of " << name << " in codimension " << codim << " is " << gridView.size( codim )
+                                              << " (" << gridView.size( type ) << " of type " << type << ") instead of "
+                                              << ids[ codim ].size() << "." );
+  }
+}
+
+template< class Grid >
+void checkSizes ( const Grid &grid )
+{
+  for( int level = 0; level <= grid.maxLevel(); ++level )
+    checkSizes( grid.levelGridView( level ), "level " + std::to_string( level ) );
+  checkSizes( grid.leafGridView(), "leaf" );
+}
+
+// refine and coarsen locally, the cached sizes of unchanged levels are kept
+template< class Grid >
+void checkLocalAdaptationSizes ( Grid &grid )
+{
+  std::cout << ">>> Checking sizes after local adaptation..." << std::endl;
+
+  // query all sizes, so that they are cached before each adaptation
+  checkSizes( grid );
+
+  // refine one element twice, creating new levels
+  for( int i = 0; i < 2; ++i )
+  {
+    markOne( grid, 0, 1 );
+    checkSizes( grid );
+  }
+
+  // refine the last leaf element, which is probably on a coarse level
+  markOne( grid, grid.size( 0 )-1, 1 );
+  checkSizes( grid );
+
+  // coarsen the finest elements, twice
+  for( int i = 0; i < 2; ++i )
+  {
+    const int maxLevel = grid.maxLevel();
+    for( const auto &element : elements( grid.leafGridView() ) )
+    {
+      if( element.level() == maxLevel )
+        grid.mark( -1, element );
+    }
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+    checkSizes( grid );
+  }
+}
+
 template< class Grid, int dim >
 void addToGridFactory ( Dune::GridFactory< Grid > &factory, Dune::Dim< dim > );
 
@@ -127,11 +201,13 @@ try {
 #if ALBERTA_DIM == 2 && GRIDDIM == 2
   std::cout << "Check GridFactory ..." <<std::endl;
   Dune::checkGridFactory< GridType >( Dune::TestGrids::kuhn2d );
+  Dune::checkBulkInsertion< GridType >( Dune::TestGrids::kuhn2d );
 #endif // #if ALBERTA_DIM == 2 && GRIDDIM == 2
 
 #if ALBERTA_DIM == 3 && GRIDDIM == 3
   std::cout << "Check GridFactory ..." <<std::endl;
   Dune::checkGridFactory< GridType >( Dune::TestGrids::kuhn3d );
+  Dune::checkBulkInsertion< GridType >( Dune::TestGrids::kuhn3d );
 #endif // #if ALBERTA_DIM == 3 && GRIDDIM == 3
 
   std::string filename;
@@ -208,6 +284,8 @@ try {
       checkIterators( grid.leafGridView() );
     }
 
+    checkLocalAdaptationSizes( grid );
+
     checkGeometryInFather(grid);
     checkIntersectionIterator(grid,true);
     checkTwists( grid.leafGridView(), NoMapTwist() );
@@ -8,10 +8,13 @@
 
 #include <dune/grid/onedgrid.hh>
 
+#include <doc/grids/gridfactory/testgrids.hh>
+
 #include "gridcheck.hh"
 #include "checkgeometryinfather.hh"
 #include "checkintersectionit.hh"
 #include "checkadaptation.hh"
+#include "checkgridfactory.hh"
 
 using namespace Dune;
 
@@ -157,6 +160,18 @@ int main () try
 
   testOneDGrid(*factoryGrid);
 
+  // Insert the same mesh in bulk, once into the OneDGrid factory and once through
+  // the default implementations of the bulk insertion methods.
+  // The OneDGrid factory does not provide insertion indices of elements and vertices.
+  const TestGrid<1> mesh = {
+    { {0.6}, {1.0}, {0.2}, {0.0}, {0.4}, {0.3}, {0.7} },
+    { {TestGrids::line, {6,1}}, {TestGrids::line, {4,0}}, {TestGrids::line, {0,6}},
+      {TestGrids::line, {5,4}}, {TestGrids::line, {3,2}}, {TestGrids::line, {2,5}} },
+    { {1}, {3} }
+  };
+  checkBulkInsertion<OneDGrid>(mesh, false);
+  checkBulkInsertion<OneDGrid, DefaultBulkInsertionFactory<OneDGrid> >(mesh, false);
+
   // Create a OneDGrid with an array of vertex coordinates and test it
   std::vector<double> coords = {-1,
                                 -0.4,
@@ -13,12 +13,14 @@
  */
 #include <dune/grid/uggrid.hh>
 #include <doc/grids/gridfactory/hybridtestgrids.hh>
+#include <doc/grids/gridfactory/testgrids.hh>
 
 #include "gridcheck.hh"
 #include "checkcommunicate.hh"
 #include "checkgeometryinfather.hh"
 #include "checkintersectionit.hh"
 #include "checkpartition.hh"
+#include "checkgridfactory.hh"
 
 
 using namespace Dune;
@@ -161,6 +163,18 @@ void generalTests(bool greenClosure)
     assert(cArray[i] == (*((std::array<double,3>*)&cArray))[i]);
   }
 
+  // //////////////////////////////////////////////////////////
+  //   Check the bulk insertion into the grid factory, both the
+  //   UGGrid implementation and the default implementation
+  // //////////////////////////////////////////////////////////
+
+  checkBulkInsertion<UGGrid<2> >(TestGrids::hybrid2d);
+  checkBulkInsertion<UGGrid<2>, DefaultBulkInsertionFactory<UGGrid<2> > >(TestGrids::hybrid2d);
+  checkBulkInsertion<UGGrid<2> >(TestGrids::kuhn2d);
+  checkBulkInsertion<UGGrid<3> >(TestGrids::hybrid3d);
+  checkBulkInsertion<UGGrid<3>, DefaultBulkInsertionFactory<UGGrid<3> > >(TestGrids::hybrid3d);
+  checkBulkInsertion<UGGrid<3> >(TestGrids::kuhn3d);
+
   // //////////////////////////////////////////////////////////
   //   Make some grids for testing
   // //////////////////////////////////////////////////////////
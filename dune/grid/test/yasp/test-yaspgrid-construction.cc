@@ -0,0 +1,201 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include <config.h>
+
+#include <array>
+#include <bitset>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/grid/yaspgrid.hh>
+
+/** \file
+ * \brief Measure the construction phases of YaspGrid and check that the
+ *        per-process communication data does not grow with the number of processes
+ *
+ * The grid is scaled with the number of processes (weak scaling). The
+ * reported times are the maxima over all processes. The intersection phases
+ * of makelevel are timed by computing the communication lists of the finest
+ * level once more; the remainder of globalRefine() covers the refinement of
+ * the coordinates, the construction of the grid components and the index sets.
+ */
+
+// gives access to the computation of the communication lists
+template<int dim>
+class TimedYaspGrid
+  : public Dune::YaspGrid<dim>
+{
+  typedef Dune::YaspGrid<dim> Base;
+
+public:
+  using Base::Base;
+
+  // time the computation of the interiorborder lists and of the overlap lists on the finest level
+  std::array<double,2> intersectionTimes ()
+  {
+    typedef std::deque<typename Base::Intersection> List;
+    auto& g = *this->begin(this->maxLevel());
+    std::array<double,2> times;
+    Dune::Timer watch;
+
+    for (std::size_t k = 0; k < g.interiorborder_data.size(); ++k)
+    {
+      List send, recv;
+      this->intersections(g.interiorborder_data[k], g.interiorborder_data[k], send, recv);
+    }
+    times[0] = watch.elapsed();
+
+    watch.reset();
+    if (g.overlapSize > 0)
+      for (std::size_t k = 0; k < g.overlapfront_data.size(); ++k)
+      {
+        List send, recv;
+        this->intersections(g.overlapfront_data[k], g.overlapfront_data[k], send, recv);
+        this->intersections(g.overlap_data[k], g.overlapfront_data[k], send, recv);
+        this->intersections(g.interiorborder_data[k], g.overlapfront_data[k], send, recv);
+      }
+    times[1] = watch.elapsed();
+    return times;
+  }
+};
+
+// the number of intersections a communication list of the given codimension holds:
+// one per grid component and per neighbor that shares entities of this component.
+// Lists of the interiorborder only reach the neighbors across the interface, i.e. only
+// those that are not offset in a direction in which the component is extended.
+template<class Grid>
+int expectedListSize (const Grid& grid, int codim, bool interfaceOnly)
+{
+  const int dim = Grid::dimension;
+  const auto coord = grid.torus().coord();
+
+  int neighborCodes = 1;
+  for (int k=0; k<dim; ++k)
+    neighborCodes *= 3;
+
+  int count = 0;
+  for (unsigned int index = 0; index < (1u<<dim); ++index)
+  {
+    std::bitset<dim> r(index);
+    if (int(r.count()) != dim-codim)
+      continue;
+
+    for (int code = 0; code < neighborCodes; ++code)
+    {
+      bool self = true, exists = true, shares = true;
+      for (int k=0, c=code; k<dim; ++k, c/=3)
+      {
+        const int delta = c%3 - 1;
+        if (delta == 0)
+          continue;
+        self = false;
+        if (coord[k] + delta < 0 || coord[k] + delta >= grid.torus().dims(k))
+          exists = false;
+        if (interfaceOnly && r[k])
+          shares = false;
+      }
+      if (!self && exists && shares)
+        ++count;
+    }
+  }
+  return count;
+}
+
+template<class List>
+void checkList (const List& list, int expected, const std::string& name, int codim)
+{
+  if (list.size() != expected)
+    DUNE_THROW(Dune::GridError, "Communication list " << name << " of codim " << codim << " holds "
+               << list.size() << " intersections instead of " << expected);
+}
+
+template<int dim>
+void benchmark (int refCount, int overlap)
+{
+  typedef TimedYaspGrid<dim> Grid;
+  typename Grid::CollectiveCommunicationType cc(Dune::MPIHelper::getCommunicator());
+
+  Dune::FieldVector<double,dim> L(1.0);
+  std::array<int,dim> s;
+  std::fill(s.begin(), s.end(), 8);
+  s[0] *= cc.size();
+
+  // per level: total time, interiorborder intersections, overlap intersections
+  std::vector<double> times;
+  Dune::Timer watch;
+
+  // torus setup and level 0
+  Grid grid(L, s, std::bitset<dim>(0ULL), overlap, cc);
+  times.push_back(watch.elapsed());
+  for (double t : grid.intersectionTimes())
+    times.push_back(t);
+
+  for (int l=0; l<refCount; ++l)
+  {
+    watch.reset();
+    grid.globalRefine(1);
+    times.push_back(watch.elapsed());
+    for (double t : grid.intersectionTimes())
+      times.push_back(t);
+  }
+
+  cc.max(times.data(), times.size());
+
+  if (cc.rank() == 0)
+  {
+    std::cout << "YaspGrid<" << dim << "> on " << cc.size() << " process(es), overlap " << overlap << ":" << std::endl;
+    for (int l=0; l<=refCount; ++l)
+    {
+      const double* t = &times[3*l];
+      std::cout << "  " << (l == 0 ? "constructor (torus + level 0)" : "globalRefine to level " + std::to_string(l))
+                << ": " << t[0] << " s" << std::endl
+                << "    makelevel, interiorborder intersections: " << t[1] << " s" << std::endl
+                << "    makelevel, overlap intersections:        " << t[2] << " s" << std::endl
+                << "    remainder:                               " << t[0] - t[1] - t[2] << " s" << std::endl;
+    }
+  }
+
+  // without overlap, the lists towards the overlapfront are the interiorborder lists
+  // and there is no overlap to send
+  const bool zeroOverlap = (overlap == 0);
+  for (auto g = grid.begin(); g != grid.end(); ++g)
+    for (int codim=0; codim<=dim; ++codim)
+    {
+      const int interfaceSize = expectedListSize(grid, codim, true);
+      const int overlapSize = zeroOverlap ? interfaceSize : expectedListSize(grid, codim, false);
+      checkList(g->send_overlapfront_overlapfront[codim], overlapSize, "send_overlapfront_overlapfront", codim);
+      checkList(g->recv_overlapfront_overlapfront[codim], overlapSize, "recv_overlapfront_overlapfront", codim);
+      checkList(g->send_overlap_overlapfront[codim], zeroOverlap ? 0 : overlapSize, "send_overlap_overlapfront", codim);
+      checkList(g->recv_overlapfront_overlap[codim], zeroOverlap ? 0 : overlapSize, "recv_overlapfront_overlap", codim);
+      checkList(g->send_interiorborder_interiorborder[codim], interfaceSize, "send_interiorborder_interiorborder", codim);
+      checkList(g->recv_interiorborder_interiorborder[codim], interfaceSize, "recv_interiorborder_interiorborder", codim);
+      checkList(g->send_interiorborder_overlapfront[codim], overlapSize, "send_interiorborder_overlapfront", codim);
+      checkList(g->recv_overlapfront_interiorborder[codim], overlapSize, "recv_overlapfront_interiorborder", codim);
+    }
+}
+
+int main (int argc , char **argv) {
+  try {
+    // Initialize MPI, if present
+    Dune::MPIHelper::instance(argc, argv);
+
+    benchmark<2>(3, 1);
+    benchmark<2>(3, 0);
+    benchmark<3>(2, 1);
+    benchmark<3>(2, 0);
+
+  } catch (Dune::Exception &e) {
+    std::cerr << e << std::endl;
+    return 1;
+  } catch (...) {
+    std::cerr << "Generic exception!" << std::endl;
+    return 2;
+  }
+
+  return 0;
+}
@@ -3,7 +3,13 @@
 #ifndef DUNE_GRID_TEST_TEST_YASPGRID_HH
 #define DUNE_GRID_TEST_TEST_YASPGRID_HH
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
 
 #include <dune/grid/test/gridcheck.hh>
 #include <dune/grid/test/checkcommunicate.hh>
@@ -26,7 +32,7 @@ template<int dim>
 struct YaspFactory<dim, Dune::EquidistantCoordinates<double,dim> >
 {
   static Dune::YaspGrid<dim>* buildGrid(
-      bool keepPhysicalOverlap = true, int refCount = 0, bool periodic = false)
+      bool keepPhysicalOverlap = true, int refCount = 0, bool periodic = false, int overlap = 1)
   {
     std::cout << " using equidistant coordinate container!" << std::endl << std::endl;
 
@@ -38,7 +44,6 @@ struct YaspFactory<dim, Dune::EquidistantCoordinates<double,dim> >
       std::fill(s.begin(), s.end(), 4);
     std::bitset<dim> p(0);
     p[0] = periodic;
-    int overlap = 1;
 
     auto grid = new Dune::YaspGrid<dim>(Len,s,p,overlap);
     grid->refineOptions (keepPhysicalOverlap);
@@ -51,7 +56,7 @@ template<int dim>
 struct YaspFactory<dim, Dune::EquidistantOffsetCoordinates<double,dim> >
 {
   static Dune::YaspGrid<dim, Dune::EquidistantOffsetCoordinates<double,dim> >* buildGrid(
-      bool keepPhysicalOverlap = true, int refCount = 0, bool periodic = false)
+      bool keepPhysicalOverlap = true, int refCount = 0, bool periodic = false, int overlap = 1)
   {
     std::cout << " using equidistant coordinate container with non-zero origin!" << std::endl << std::endl;
 
@@ -64,7 +69,6 @@ struct YaspFactory<dim, Dune::EquidistantOffsetCoordinates<double,dim> >
       std::fill(s.begin(), s.end(), 4);
     std::bitset<dim> p(0);
     p[0] = periodic;
-    int overlap = 1;
 
     auto grid = new Dune::YaspGrid<dim, Dune::EquidistantOffsetCoordinates<double,dim> >(lowerleft,upperright,s,p,overlap);
     grid->refineOptions (keepPhysicalOverlap);
@@ -77,13 +81,12 @@ template<int dim>
 struct YaspFactory<dim, Dune::TensorProductCoordinates<double,dim> >
 {
   static Dune::YaspGrid<dim, Dune::TensorProductCoordinates<double,dim> >* buildGrid(
-      bool keepPhysicalOverlap = true, int refCount = 0, bool periodic = false)
+      bool keepPhysicalOverlap = true, int refCount = 0, bool periodic = false, int overlap = 1)
   {
     std::cout << " using tensorproduct coordinate container!" << std::endl << std::endl;
 
     std::bitset<dim> p(0);
     p[0] = periodic;
-    int overlap = 1;
 
     std::array<std::vector<double>,dim> coords;
     if (dim < 3) {
@@ -121,6 +124,55 @@ struct YaspFactory<dim, Dune::TensorProductCoordinates<double,dim> >
   }
 };
 
+// collect the indices described by an index box, in the order of a structured loop
+template <int dim>
+std::vector<int> indexBoxIndices(const Dune::YaspIndexBox<dim>& box)
+{
+  std::vector<int> indices;
+  if (box.empty())
+    return indices;
+
+  std::array<int,dim> c = box.origin();
+  while (true)
+  {
+    indices.push_back(box.index(c));
+    int i = 0;
+    for (; i < dim && ++c[i] > box.max(i); ++i)
+      c[i] = box.min(i);
+    if (i == dim)
+      return indices;
+  }
+}
+
+// check that the index boxes cover exactly the indices of the entities of each partition
+template <int codim, Dune::PartitionIteratorType pitype, int dim, class CC>
+void check_indexbox(const Dune::YaspGrid<dim,CC>& grid)
+{
+  const auto gv = grid.leafGridView();
+  std::vector<int> expected;
+  for (const auto& e : entities(gv, Dune::Codim<codim>(), Dune::partitionSet<pitype>()))
+    expected.push_back(gv.indexSet().index(e));
+
+  std::vector<int> indices = indexBoxIndices(grid.indexBox(grid.maxLevel(), codim, pitype));
+
+  std::sort(expected.begin(), expected.end());
+  std::sort(indices.begin(), indices.end());
+  if (indices != expected)
+    DUNE_THROW(Dune::GridError, "YaspGrid::indexBox does not match the index set for codim "
+               << codim << " and partition " << pitype);
+}
+
+template <int dim, class CC>
+void check_indexbox(const Dune::YaspGrid<dim,CC>& grid)
+{
+  check_indexbox<0, Dune::Interior_Partition>(grid);
+  check_indexbox<0, Dune::InteriorBorder_Partition>(grid);
+  check_indexbox<0, Dune::All_Partition>(grid);
+  check_indexbox<dim, Dune::Interior_Partition>(grid);
+  check_indexbox<dim, Dune::InteriorBorder_Partition>(grid);
+  check_indexbox<dim, Dune::All_Partition>(grid);
+}
+
 template <int dim, class CC>
 void check_yasp(Dune::YaspGrid<dim,CC>* grid) {
   std::cout << std::endl << "YaspGrid<" << dim << ">";
@@ -147,6 +199,7 @@ void check_yasp(Dune::YaspGrid<dim,CC>* grid) {
   // check grid adaptation interface
   checkAdaptRefinement(*grid);
   checkPartitionType( grid->leafGridView() );
+  check_indexbox(*grid);
 
   std::ofstream file;
   std::ostringstream filename;
@@ -1007,5 +1007,7 @@ namespace Dune {
 
 } // namespace Dune
 
+#include <dune/grid/uggrid/uggridpersistentcontainer.hh>
+
 #endif   // HAVE_UG || DOXYGEN
 #endif   // DUNE_UGGRID_HH
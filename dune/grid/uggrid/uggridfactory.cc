@@ -107,10 +107,68 @@ insertVertex(const FieldVector<typename GridFactory<UGGrid<dimworld> >::ctype,di
   vertexPositions_.push_back(pos);
 }
 
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertVertices(const std::vector<ctype>& coordinates)
+{
+  if (coordinates.size() % dimworld != 0)
+    DUNE_THROW(GridError, "The number of coordinates " << coordinates.size()
+               << " is not a multiple of the world dimension " << dimworld << "!");
+
+  vertexPositions_.reserve(vertexPositions_.size() + coordinates.size()/dimworld);
+  FieldVector<double,dimworld> pos;
+  for (std::size_t i=0; i<coordinates.size(); i+=dimworld) {
+    for (int k=0; k<dimworld; k++)
+      pos[k] = coordinates[i+k];
+    vertexPositions_.push_back(pos);
+  }
+}
+
 template <int dimworld>
 void GridFactory<UGGrid<dimworld> >::
 insertElement(const GeometryType& type,
               const std::vector<unsigned int>& vertices)
+{
+  appendElement(type, vertices.data(), vertices.size());
+}
+
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertElements(const GeometryType& type,
+               const std::vector<unsigned int>& vertices)
+{
+  if (dimworld!=type.dim())
+    DUNE_THROW(GridError, "You cannot insert a " << type
+                                                 << " into a UGGrid<" << dimworld << ">!");
+
+  const unsigned int numCorners = ReferenceElements<double,dimworld>::general(type).size(dimworld);
+  if (vertices.size() % numCorners != 0)
+    DUNE_THROW(GridError, "The number of vertices " << vertices.size()
+               << " is not a multiple of the number of corners of a " << type << "!");
+
+  elementTypes_.reserve(elementTypes_.size() + vertices.size()/numCorners);
+  elementVertices_.reserve(elementVertices_.size() + vertices.size());
+  for (std::size_t i=0; i<vertices.size(); i+=numCorners)
+    appendElement(type, vertices.data() + i, numCorners);
+}
+
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertElements(const std::vector<GeometryType>& types,
+               const std::vector<unsigned int>& offsets,
+               const std::vector<unsigned int>& vertices)
+{
+  this->checkOffsets(types, offsets, vertices);
+
+  elementTypes_.reserve(elementTypes_.size() + types.size());
+  elementVertices_.reserve(elementVertices_.size() + vertices.size());
+  for (std::size_t i=0; i<types.size(); i++)
+    appendElement(types[i], vertices.data() + offsets[i], offsets[i+1] - offsets[i]);
+}
+
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+appendElement(const GeometryType& type, const unsigned int* vertices, unsigned int numVertices)
 {
   if (dimworld!=type.dim())
     DUNE_THROW(GridError, "You cannot insert a " << type
@@ -118,21 +176,20 @@ insertElement(const GeometryType& type,
 
   int newIdx = elementVertices_.size();
 
-  elementTypes_.push_back(vertices.size());
-  for (unsigned int i=0; i<vertices.size(); i++)
-    elementVertices_.push_back(vertices[i]);
+  elementTypes_.push_back(numVertices);
+  elementVertices_.insert(elementVertices_.end(), vertices, vertices + numVertices);
 
   if (type.isTriangle()) {
     // Everything alright
-    if (vertices.size() != 3)
+    if (numVertices != 3)
       DUNE_THROW(GridError, "You have requested to enter a triangle, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+                 << " have provided " << numVertices << " vertices!");
 
   } else if (type.isQuadrilateral()) {
 
-    if (vertices.size() != 4)
+    if (numVertices != 4)
       DUNE_THROW(GridError, "You have requested to enter a quadrilateral, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+                 << " have provided " << numVertices << " vertices!");
 
     // DUNE and UG numberings differ --> reorder the vertices
     elementVertices_[newIdx+2] = vertices[3];
@@ -140,15 +197,15 @@ insertElement(const GeometryType& type,
 
   } else if (type.isTetrahedron()) {
 
-    if (vertices.size() != 4)
+    if (numVertices != 4)
       DUNE_THROW(GridError, "You have requested to enter a tetrahedron, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+                 << " have provided " << numVertices << " vertices!");
 
   } else if (type.isPyramid()) {
 
-    if (vertices.size() != 5)
+    if (numVertices != 5)
       DUNE_THROW(GridError, "You have requested to enter a pyramid, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+                 << " have provided " << numVertices << " vertices!");
 
     // DUNE and UG numberings differ --> reorder the vertices
     elementVertices_[newIdx+2] = vertices[3];
@@ -156,15 +213,15 @@ insertElement(const GeometryType& type,
 
   } else if (type.isPrism()) {
 
-    if (vertices.size() != 6)
+    if (numVertices != 6)
       DUNE_THROW(GridError, "You have requested to enter a prism, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+                 << " have provided " << numVertices << " vertices!");
 
   } else if (type.isHexahedron()) {
 
-    if (vertices.size() != 8)
+    if (numVertices != 8)
       DUNE_THROW(GridError, "You have requested to enter a hexahedron, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+                 << " have provided " << numVertices << " vertices!");
 
     // DUNE and UG numberings differ --> reorder the vertices
     elementVertices_[newIdx+2] = vertices[3];
@@ -196,6 +196,27 @@ namespace Dune {
     virtual void insertElement(const GeometryType& type,
                                const std::vector<unsigned int>& vertices);
 
+    /** \brief Insert several vertices into the coarse grid
+        \param coordinates The coordinates of the vertices, dimworld consecutive values per vertex
+     */
+    virtual void insertVertices(const std::vector<ctype>& coordinates);
+
+    /** \brief Insert several elements of the same type into the coarse grid
+        \param type The GeometryType of the new elements
+        \param vertices The vertices of the new elements, using the DUNE numbering
+     */
+    virtual void insertElements(const GeometryType& type,
+                                const std::vector<unsigned int>& vertices);
+
+    /** \brief Insert several elements of possibly different types into the coarse grid
+        \param types The GeometryTypes of the new elements
+        \param offsets Offsets of the vertices of each element (CSR format)
+        \param vertices The vertices of the new elements, using the DUNE numbering
+     */
+    virtual void insertElements(const std::vector<GeometryType>& types,
+                                const std::vector<unsigned int>& offsets,
+                                const std::vector<unsigned int>& vertices);
+
     /** \brief Method to insert a boundary segment into a coarse grid
 
        Using this method is optional.  It only influences the ordering of the segments
@@ -268,6 +289,9 @@ namespace Dune {
     // Initialize the grid structure in UG
     void createBegin();
 
+    // Append an element to elementTypes_ and elementVertices_
+    void appendElement(const GeometryType& type, const unsigned int* vertices, unsigned int numVertices);
+
     // Pointer to the grid being built
     UGGrid<dimworld>* grid_;
 
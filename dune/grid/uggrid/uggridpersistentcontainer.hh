@@ -0,0 +1,48 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_UGGRID_PERSISTENTCONTAINER_HH
+#define DUNE_UGGRID_PERSISTENTCONTAINER_HH
+
+/** \file
+ * \brief Specialization of the PersistentContainer for UGGrid
+ */
+
+#include <unordered_map>
+
+#include <dune/grid/utility/persistentcontainer.hh>
+#include "../uggrid.hh"
+
+namespace Dune
+{
+
+  /** \brief Specialization of the PersistentContainer for UGGrid
+   *
+   *  UGGrid identifies its entities by integral ids, which are stored in a
+   *  hash map.  This avoids the logarithmic lookup of the default container
+   *  in every data access during an adaptation cycle.
+   *
+   *  std::unordered_map is used rather than a table with open addressing:
+   *  the ids are counters, and the common standard libraries hash integers to
+   *  themselves, so entities created together stay close in memory.  On
+   *  large grids this outweighs the allocation per node.
+   */
+  template< int dim, class T >
+  class PersistentContainer< UGGrid< dim >, T >
+    : public PersistentContainerMap< UGGrid< dim >, typename UGGrid< dim >::LocalIdSet,
+                                     std::unordered_map< typename UGGrid< dim >::LocalIdSet::IdType, T > >
+  {
+    typedef PersistentContainerMap< UGGrid< dim >, typename UGGrid< dim >::LocalIdSet,
+                                    std::unordered_map< typename UGGrid< dim >::LocalIdSet::IdType, T > > Base;
+
+  public:
+    typedef typename Base::Grid Grid;
+    typedef typename Base::Value Value;
+
+    PersistentContainer ( const Grid &grid, int codim, const Value &value = Value() )
+      : Base( grid, codim, grid.localIdSet(), value )
+    {}
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_UGGRID_PERSISTENTCONTAINER_HH
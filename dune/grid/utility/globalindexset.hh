@@ -14,19 +14,21 @@
  *
  *  Method: (1) The UniqueEntityPartition class assigns an owner process to each entity
  *
- *          (2) Compute the number of entities that are owned by each process
+ *          (2) Compute the number of entities that are owned by each process, and the
+ *              number of entities owned by the processes of lower rank by an exclusive scan
  *
  *          (3) we communicate the index of entities that are owned by the process to processes
  *              that also contain these entities but do not own them, so that on a non-owner process
  *              we have information on the index of the entity that it got from the owner-process;
  *
+ *  After load balancing, the index set can be updated with the indices carried along with
+ *  the migrated entities, see GlobalIndexSet::LoadBalanceHandle.
+ *
  *  \author    Benedikt Oswald, Patrick Leidenberger, Oliver Sander
  *
  *  \attention globally unique indices are ONLY provided for entities of the
  *             InteriorBorder_Partition type, NOT for the Ghost_Partition type !!!
  *
- *  \bug This code will most likely not work on grids with more than one element type.
- *       Please ask on the mailing list if you need this feature.
  *  \note The interface in this file is experimental, and may change without prior notice.
  */
 
@@ -35,20 +37,23 @@
 
 /** \brief Include standard header files. */
 #include <vector>
-#include <iostream>
-#include <fstream>
 #include <memory>
-#include <map>
-#include <utility>
+#include <numeric>
+#include <type_traits>
 #include <algorithm>
+#include <utility>
+
+#include <dune/geometry/type.hh>
 
 /** include base class functionality for the communication interface */
 #include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/mcmgmapper.hh>
 
 /** include parallel capability */
 #if HAVE_MPI
   #include <dune/common/parallel/mpihelper.hh>
+  #include <dune/common/parallel/mpitraits.hh>
 #endif
 
 namespace Dune
@@ -95,18 +100,15 @@ namespace Dune
     /** define data types */
     typedef typename GridView::Grid Grid;
 
-    typedef typename GridView::Grid::GlobalIdSet GlobalIdSet;
-    typedef typename GridView::Grid::GlobalIdSet::IdType IdType;
-    typedef typename GridView::Traits::template Codim<0>::Iterator Iterator;
-
     typedef typename Grid::CollectiveCommunication CollectiveCommunication;
 
-    typedef std::map<IdType,Index> MapId2Index;
-    typedef std::map<Index,Index>    IndexMap;
+    typedef typename Grid::GlobalIdSet::IdType IdType;
+
+    /** \brief Consecutive local index of all entities of one codimension, for all geometry types */
+    typedef MultipleCodimMultipleGeomTypeMapper<GridView> Mapper;
 
     /*********************************************************************************************/
-    /* calculate unique partitioning for all entities of a given codim in a given GridView,      */
-    /* assuming they all have the same geometry, i.e. codim, type                                */
+    /* calculate unique partitioning for all entities of a given codim in a given GridView       */
     /*********************************************************************************************/
     class UniqueEntityPartition
     {
@@ -177,12 +179,9 @@ namespace Dune
     public:
       /*! \brief Constructor needs to know the grid function space
        */
-      UniqueEntityPartition (const GridView& gridview, unsigned int codim)
-      : assignment_(gridview.size(codim))
+      UniqueEntityPartition (const GridView& gridview, const Mapper& mapper, unsigned int codim)
+      : assignment_(mapper.size())
       {
-        /** extract types from the GridView data type */
-        typedef typename GridView::IndexSet IndexSet;
-
         // assign own rank to entities that I might have
         for (auto it = gridview.template begin<0>(); it!=gridview.template end<0>(); ++it)
           for (unsigned int i=0; i<it->subEntities(codim); i++)
@@ -191,16 +190,17 @@ namespace Dune
             // However, we only have it as a run-time parameter.
             PartitionType subPartitionType = SubPartitionTypeProvider<typename GridView::template Codim<0>::Entity, GridView::dimension>::get(*it,codim,i);
 
-            assignment_[gridview.indexSet().subIndex(*it,i,codim)]
+            assignment_[mapper.subIndex(*it,i,codim)]
               = ( subPartitionType==Dune::InteriorEntity or subPartitionType==Dune::BorderEntity )
               ? gridview.comm().rank()  // set to own rank
               : - 1;   // it is a ghost entity, I will not possibly own it.
           }
 
-        /** exchange entity index through communication */
-        MinimumExchange<IndexSet,std::vector<Index> > dh(gridview.indexSet(),assignment_,codim);
+        /** exchange entity index through communication; only interior and border entities
+         *  are candidates, so they only need to talk to each other */
+        MinimumExchange<Mapper,std::vector<Index> > dh(mapper,assignment_,codim);
 
-        gridview.communicate(dh,Dune::All_All_Interface,Dune::ForwardCommunication);
+        gridview.communicate(dh,Dune::InteriorBorder_InteriorBorder_Interface,Dune::ForwardCommunication);
       }
 
       /** \brief Which rank is the i-th entity assigned to? */
@@ -254,12 +254,7 @@ namespace Dune
       template<class MessageBuffer, class EntityType>
       void gather (MessageBuffer& buff, const EntityType& e) const
       {
-        IdType id=globalidset_.id(e);
-
-        if (indexSetCodim_==0)
-          buff.write(mapid2entity_[id]);
-        else
-          buff.write((*mapid2entity_.find(id)).second);
+        buff.write(globalIndex_[mapper_.index(e)]);
       }
 
       /** \brief Unpack data from message buffer to user
@@ -279,83 +274,54 @@ namespace Dune
          *  that non-owning processes use -1 to mark an entity
          *  that they do not own.
          */
-        if(x >= 0) {
-          const IdType id = globalidset_.id(entity);
-
-          if (indexSetCodim_==0)
-            mapid2entity_[id] = x;
-          else
-          {
-            mapid2entity_.erase(id);
-            mapid2entity_.insert(std::make_pair(id,x));
-
-            const Index lindex = indexSet_.index(entity);
-            localGlobalMap_[lindex] = x;
-          }
-        }
+        if(x >= 0)
+          globalIndex_[mapper_.index(entity)] = x;
       }
 
       //! constructor
-      IndexExchange (const GlobalIdSet& globalidset, MapId2Index& mapid2entity,
-                     const typename GridView::IndexSet& localIndexSet, IndexMap& localGlobal,
-                     unsigned int indexSetCodim)
-      : globalidset_(globalidset),
-      mapid2entity_(mapid2entity),
-      indexSet_(localIndexSet),
-      localGlobalMap_(localGlobal),
+      IndexExchange (const Mapper& mapper, std::vector<Index>& globalIndex, unsigned int indexSetCodim)
+      : mapper_(mapper),
+      globalIndex_(globalIndex),
       indexSetCodim_(indexSetCodim)
       {}
 
     private:
-      const GlobalIdSet& globalidset_;
-      MapId2Index& mapid2entity_;
-
-      const typename GridView::IndexSet& indexSet_;
-      IndexMap& localGlobalMap_;
+      const Mapper& mapper_;
+      std::vector<Index>& globalIndex_;
       unsigned int indexSetCodim_;
     };
 
-  public:
-    /** \brief Constructor for a given GridView
-     *
-     * This constructor calculates the complete set of global unique indices so that we can then
-     *  later query the global index, by directly passing the entity in question.
-     */
-    GlobalIndexSet(const GridView& gridview, int codim)
-    : gridview_(gridview),
-      codim_(codim)
+#if HAVE_MPI
+    /** \brief Number of entities owned by the processes of lower rank, using MPI_Exscan */
+    static Index exclusiveSum(const CollectiveCommunication& comm, Index nLocalEntity, std::true_type)
     {
-      int rank = gridview.comm().rank();
-      int size = gridview.comm().size();
-
-      const typename GridView::IndexSet& indexSet = gridview.indexSet();
-
-      std::unique_ptr<UniqueEntityPartition> uniqueEntityPartition;
-      if (codim_!=0)
-        uniqueEntityPartition = std::unique_ptr<UniqueEntityPartition>(new UniqueEntityPartition(gridview,codim_));
-
-      int nLocalEntity = (codim_==0)
-                    ? std::distance(gridview.template begin<0, Dune::Interior_Partition>(), gridview.template end<0, Dune::Interior_Partition>())
-                    : uniqueEntityPartition->numOwners(rank);
-
-      // Compute the global, non-redundant number of entities, i.e. the number of entities in the set
-      // without double, aka. redundant entities, on the interprocessor boundary via global reduce. */
-      nGlobalEntity_ = gridview.comm().template sum<int>(nLocalEntity);
+      Index offset = 0;
+      MPI_Exscan(&nLocalEntity, &offset, 1, MPITraits<Index>::getType(), MPI_SUM, comm);
+      // the result is undefined on rank 0
+      return (comm.rank() == 0) ? 0 : offset;
+    }
 
-      /* communicate the number of locally owned entities to all other processes so that the respective offset
-       * can be calculated on the respective processor; we use the Dune mpi collective communication facility
-       * for this; first, we gather the number of locally owned entities on the root process and, second, we
-       * broadcast the array to all processes where the respective offset can be calculated. */
+    static constexpr bool hasMPIComm = std::is_convertible<CollectiveCommunication, MPI_Comm>::value;
+#else
+    static constexpr bool hasMPIComm = false;
+#endif
 
-      std::vector<int> offset(size);
-      std::fill(offset.begin(), offset.end(), 0);
+    /** \brief Number of entities owned by the processes of lower rank, for other communicators */
+    static Index exclusiveSum(const CollectiveCommunication& comm, Index nLocalEntity, std::false_type)
+    {
+      std::vector<Index> counts(comm.size());
+      comm.template allgather<Index>(&nLocalEntity, 1, counts.data());
+      return std::accumulate(counts.begin(), counts.begin() + comm.rank(), Index(0));
+    }
 
-      /** Share number of locally owned entities */
-      gridview_.comm().template allgather<int>(&nLocalEntity, 1, offset.data());
+    /** \brief Compute the global indices from scratch */
+    void computeIndices()
+    {
+      int rank = gridview_.comm().rank();
 
-      int myoffset = 0;
-      for (int i=1; i<rank+1; i++)
-        myoffset += offset[i-1];
+      std::unique_ptr<UniqueEntityPartition> uniqueEntityPartition;
+      if (codim_!=0)
+        uniqueEntityPartition = std::unique_ptr<UniqueEntityPartition>(new UniqueEntityPartition(gridview_,mapper_,codim_));
 
       /*  compute globally unique index over all processes; the idea of the algorithm is as follows: if
        *  an entity is owned by the process, it is assigned an index that is the addition of the offset
@@ -370,97 +336,211 @@ namespace Dune
        *  (2) we achieve parallel adjustment by communicating the index
        *      from the owning entity to the non-owning entity.
        *
+       *  The indices are stored in a vector, which is addressed by a mapper for the codimension.
        */
 
-      // 1st stage of global index calculation: calculate global index for owned entities
-      // initialize map that stores an entity's global index via it's globally unique id as key
-      globalIndex_.clear();
-
-      const GlobalIdSet& globalIdSet = gridview_.grid().globalIdSet();      /** retrieve globally unique Id set */
+      // 1st stage of global index calculation: number the owned entities locally
+      globalIndex_.assign(mapper_.size(), -1);
 
-      Index globalcontrib = 0;      /** initialize contribution for the global index */
-
-      if (codim_==0)  // This case is simpler
+      Index nLocalEntity = 0;
+      for (const auto& element : elements(gridview_))
       {
-        for (Iterator iter = gridview_.template begin<0>(); iter!=gridview_.template end<0>(); ++iter)
+        if (codim_==0)  // This case is simpler
         {
-          const IdType id = globalIdSet.id(*iter);      /** retrieve the entity's id */
-
           /** if the entity is owned by the process, go ahead with computing the global index */
-          if (iter->partitionType() == Dune::InteriorEntity)
-          {
-            const Index gindex = myoffset + globalcontrib;    /** compute global index */
+          if (element.partitionType() == Dune::InteriorEntity)
+            globalIndex_[mapper_.index(element)] = nLocalEntity++;
+          continue;
+        }
 
-            globalIndex_[id] = gindex;                      /** insert pair (key, datum) into the map */
-            globalcontrib++;                                /** increment contribution to global index */
-          }
+        for (unsigned int i=0; i<element.subEntities(codim_); i++)
+        {
+          const auto idx = mapper_.subIndex(element,i,codim_);
 
-          /** if entity is not owned, insert -1 to signal not yet calculated global index */
-          else
-          {
-            globalIndex_[id] = -1;     /** insert pair (key, datum) into the map */
-          }
+          /** number the entity on its first visit, if it is owned by the process */
+          if (globalIndex_[idx] < 0 && uniqueEntityPartition->owner(idx) == rank)
+            globalIndex_[idx] = nLocalEntity++;
         }
       }
-      else  // if (codim==0) else
+
+      // Compute the global, non-redundant number of entities, i.e. the number of entities in the set
+      // without double, aka. redundant entities, on the interprocessor boundary via global reduce. */
+      nGlobalEntity_ = gridview_.comm().template sum<int>(nLocalEntity);
+
+      // Shift the local numbers by the number of entities owned by the processes of lower rank
+      const Index myoffset = exclusiveSum(gridview_.comm(), nLocalEntity, std::integral_constant<bool, hasMPIComm>());
+      for (Index& index : globalIndex_)
+        if (index >= 0)
+          index += myoffset;
+
+      // 2nd stage of global index calculation: communicate global index for non-owned entities.
+      // Only interior and border entities can be owned, so only they have to send.
+      IndexExchange dataHandle(mapper_,globalIndex_,codim_);
+      gridview_.communicate(dataHandle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+    }
+
+  public:
+    /** \brief Data handle that carries the global indices of the entities through Grid::loadBalance
+     *
+     * Obtain it from loadBalanceHandle() before load balancing, pass it to
+     * the data migration of the grid, and call update() afterwards:
+     * \code
+     * auto handle = globalIndexSet.loadBalanceHandle();
+     * grid.loadBalance(handle);
+     * globalIndexSet.update(handle);
+     * \endcode
+     * On construction, the handle records the global ids and indices of the
+     * entities on this process. The indices of the entities that move to
+     * another process are sent along with them.
+     */
+    class LoadBalanceHandle
+    : public Dune::CommDataHandleIF<LoadBalanceHandle,Index>
+    {
+      friend class GlobalIndexSet;
+
+    public:
+      //! returns true if data for this codim should be communicated
+      bool contains (int dim, unsigned int codim) const
+      {
+        return codim==indexSet_.codim_;
+      }
+
+      //! returns true if size per entity of given dim and codim is a constant
+      bool fixedSize (int dim, int codim) const
+      {
+        return true;
+      }
+
+      //! one index per entity
+      template<class EntityType>
+      size_t size (EntityType& e) const
       {
-      std::vector<bool> firstTime(gridview_.size(codim_));
-      std::fill(firstTime.begin(), firstTime.end(), true);
+        return 1;
+      }
 
-      for(Iterator iter = gridview_.template begin<0>();iter!=gridview_.template end<0>(); ++iter)
+      /*! pack the global index of an entity before it is moved */
+      template<class MessageBuffer, class EntityType>
+      void gather (MessageBuffer& buff, const EntityType& e) const
       {
-        for (size_t i=0; i<iter->subEntities(codim_); i++)
-        {
-          IdType id=globalIdSet.subId(*iter,i,codim_);
+        buff.write(indexSet_.globalIndex_[indexSet_.mapper_.index(e)]);
+      }
 
-          Index idx = gridview_.indexSet().subIndex(*iter,i,codim_);
+      /*! unpack the global index of an entity that has been moved */
+      template<class MessageBuffer, class EntityType>
+      void scatter (MessageBuffer& buff, const EntityType& e, size_t n)
+      {
+        Index x;
+        buff.read(x);
+        if (x >= 0)
+          indices_.emplace_back(indexSet_.gridview_.grid().globalIdSet().id(e), x);
+      }
 
-          if (!firstTime[idx] )
+    private:
+      explicit LoadBalanceHandle (const GlobalIndexSet& indexSet)
+      : indexSet_(indexSet)
+      {
+        const auto& idSet = indexSet_.gridview_.grid().globalIdSet();
+        indices_.reserve(indexSet_.globalIndex_.size());
+        for (const auto& element : elements(indexSet_.gridview_))
+        {
+          if (indexSet_.codim_==0)
+          {
+            indices_.emplace_back(idSet.id(element), indexSet_.index(element));
             continue;
+          }
 
-          firstTime[idx] = false;
+          for (unsigned int i=0; i<element.subEntities(indexSet_.codim_); i++)
+            indices_.emplace_back(idSet.subId(element,i,indexSet_.codim_),
+                                  indexSet_.subIndex(element,i,indexSet_.codim_));
+        }
+      }
 
-          if (uniqueEntityPartition->owner(idx) == rank)  /** if the entity is owned by the process, go ahead with computing the global index */
-          {
-            const Index gindex = myoffset + globalcontrib;    /** compute global index */
-            globalIndex_.insert(std::make_pair(id,gindex)); /** insert pair (key, value) into the map */
+      const GlobalIndexSet& indexSet_;
 
-            const Index lindex = idx;
-            localGlobalMap_[lindex] = gindex;
+      //! global ids and indices of the entities known before and received during load balancing
+      std::vector<std::pair<IdType,Index> > indices_;
+    };
 
-            globalcontrib++;                                /** increment contribution to global index */
-          }
-          else /** if entity is not owned, insert -1 to signal not yet calculated global index */
-          {
-            globalIndex_.insert(std::make_pair(id,-1));
-          }
+    /** \brief Constructor for a given GridView
+     *
+     * This constructor calculates the complete set of global unique indices so that we can then
+     *  later query the global index, by directly passing the entity in question.
+     */
+    GlobalIndexSet(const GridView& gridview, int codim)
+    : gridview_(gridview),
+      codim_(codim),
+      mapper_(gridview, [codim] (GeometryType gt, int dim) { return int(gt.dim()) == dim - codim; })
+    {
+      computeIndices();
+    }
+
+    /** \brief Create a data handle that carries the global indices through Grid::loadBalance
+     *
+     * The handle refers to this index set and must not outlive it.
+     */
+    LoadBalanceHandle loadBalanceHandle() const
+    {
+      return LoadBalanceHandle(*this);
+    }
+
+    /** \brief Update the global indices after the grid has been load balanced
+     *
+     * Each entity keeps the global index it had before load balancing, so the
+     * numbering is stable across repartitions. The indices are taken from the
+     * entities that stayed on this process and from the entities received with
+     * the handle. Entities still unknown, like new ghosts, get their index from
+     * the processes that know it, in a single communication. Only if some entity
+     * cannot be resolved like this on any process, e.g. because the grid did not
+     * migrate the data of this codimension, the indices are computed from scratch.
+     *
+     * \param handle The handle passed to Grid::loadBalance
+     */
+    void update(const LoadBalanceHandle& handle)
+    {
+      std::vector<std::pair<IdType,Index> > indices(handle.indices_);
+      std::sort(indices.begin(), indices.end(),
+                [] (const std::pair<IdType,Index>& a, const std::pair<IdType,Index>& b) { return a.first < b.first; });
+
+      auto find = [&indices] (const IdType& id) -> Index {
+        auto it = std::lower_bound(indices.begin(), indices.end(), id,
+                                   [] (const std::pair<IdType,Index>& a, const IdType& b) { return a.first < b; });
+        return (it != indices.end() && it->first == id) ? it->second : -1;
+      };
+
+      mapper_.update();
+      globalIndex_.assign(mapper_.size(), -1);
+
+      const auto& idSet = gridview_.grid().globalIdSet();
+      for (const auto& element : elements(gridview_))
+      {
+        if (codim_==0)
+        {
+          globalIndex_[mapper_.index(element)] = find(idSet.id(element));
+          continue;
         }
 
-      }
+        for (unsigned int i=0; i<element.subEntities(codim_); i++)
+        {
+          const auto idx = mapper_.subIndex(element,i,codim_);
+          if (globalIndex_[idx] < 0)
+            globalIndex_[idx] = find(idSet.subId(element,i,codim_));
+        }
       }
 
-      // 2nd stage of global index calculation: communicate global index for non-owned entities
+      // Entities that are unknown here get their index from the interior and border copies
+      IndexExchange dataHandle(mapper_,globalIndex_,codim_);
+      gridview_.communicate(dataHandle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
 
-      // Create the data handle and communicate.
-      IndexExchange dataHandle(globalIdSet,globalIndex_,indexSet,localGlobalMap_,codim_);
-      gridview_.communicate(dataHandle, Dune::All_All_Interface, Dune::ForwardCommunication);
+      const bool resolved = std::find(globalIndex_.begin(), globalIndex_.end(), -1) == globalIndex_.end();
+      if (gridview_.comm().min(int(resolved)) == 0)
+        computeIndices();
     }
 
     /** \brief Return the global index of a given entity */
     template <class Entity>
     Index index(const Entity& entity) const
     {
-      if (codim_==0)
-      {
-        /** global unique index is only applicable for inter or border type entities */
-        const GlobalIdSet& globalIdSet = gridview_.grid().globalIdSet(); /** retrieve globally unique Id set */
-        const IdType id = globalIdSet.id(entity);                        /** obtain the entity's id */
-        const Index gindex = globalIndex_.find(id)->second;                /** retrieve the global index in the map with the id as key */
-
-        return gindex;
-      }
-      else
-        return localGlobalMap_.find(gridview_.indexSet().index(entity))->second;
+      return globalIndex_[mapper_.index(entity)];
     }
 
     /** \brief Return the global index of a subentity of a given entity
@@ -471,17 +551,7 @@ namespace Dune
     template <class Entity>
     Index subIndex(const Entity& entity, unsigned int i, unsigned int codim) const
     {
-      if (codim_==0)
-      {
-        /** global unique index is only applicable for inter or border type entities */
-        const GlobalIdSet& globalIdSet = gridview_.grid().globalIdSet(); /** retrieve globally unique Id set */
-        const IdType id = globalIdSet.subId(entity,i,codim);                        /** obtain the entity's id */
-        const Index gindex = globalIndex_.find(id)->second;                /** retrieve the global index in the map with the id as key */
-
-        return gindex;
-      }
-      else
-        return localGlobalMap_.find(gridview_.indexSet().subIndex(entity,i,codim))->second;
+      return globalIndex_[mapper_.subIndex(entity,i,codim)];
     }
 
     /** \brief Return the total number of entities over all processes that we have indices for
@@ -503,11 +573,12 @@ namespace Dune
     //! Global number of entities, i.e. number of entities without rendundant entities on interprocessor boundaries
     int nGlobalEntity_;
 
-    IndexMap localGlobalMap_;
+    /** \brief Maps the entities of codimension codim_ to consecutive local indices */
+    Mapper mapper_;
 
-    /** \brief Stores global index of entities with entity's globally unique id as key
+    /** \brief Stores the global index of the entities, addressed by the mapper
      */
-    MapId2Index globalIndex_;
+    std::vector<Index> globalIndex_;
   };
 
 }  // namespace Dune
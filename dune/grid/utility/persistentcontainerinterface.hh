@@ -24,6 +24,8 @@ namespace Dune
    *
    *  After grid modification the method resize must be called to ensure entries
    *  for each entity in the modified grid.
+   *  Alternatively, the method postRefinement can be called for each refined
+   *  element, which only adds the entries of the new entities.
    *  Accessing newly created entities before calling resize results in
    *  undefined behavior (e.g., a segmentation fault).
    *  To reduce the amount of overallocated entries, the method shrinkToFit
@@ -138,6 +140,36 @@ namespace Dune
      */
     void resize ( const Value &value = Value() );
 
+    /** \brief add entries for the children of a refined element
+     *
+     *  This method may be called after a grid modification for each element
+     *  that has been refined, instead of calling resize.
+     *  It adds entries for the children of the element or, if the container
+     *  is attached to a higher codimension, for their subentities.
+     *  Its name and signature match AdaptDataHandleInterface::postRefinement.
+     *
+     *  \note Depending on the implementation, this might be as expensive as
+     *        calling resize.
+     */
+    template< class Entity >
+    void postRefinement ( const Entity &father, const Value &value = Value() );
+
+    /** \brief remove the entries of the children of an element to be coarsened
+     *
+     *  This method may be called before a grid modification for each element
+     *  whose children are about to vanish.
+     *  For higher codimensions, only the entries of subentities that are not
+     *  shared with remaining elements are removed.
+     *  This requires that all refinements since the last call to resize have
+     *  been passed to postRefinement.
+     *  Its name and signature match AdaptDataHandleInterface::preCoarsening.
+     *
+     *  \note This method is merely a hint to the container, like
+     *        shrinkToFit.
+     */
+    template< class Entity >
+    void preCoarsening ( const Entity &father );
+
     /** \brief remove unnecessary entries from container
      *
      *  This method will remove entries from the container that can no longer
@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <map>
+#include <unordered_map>
 
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/std/utility.hh>
@@ -14,6 +16,32 @@
 namespace Dune
 {
 
+  namespace Impl
+  {
+
+    // map type for the number of elements containing an id, derived from the data map
+    template< class Map >
+    struct PersistentContainerCountMap
+    {
+      typedef std::map< typename Map::key_type, unsigned int > Type;
+    };
+
+    template< class Key, class T, class Compare, class Allocator >
+    struct PersistentContainerCountMap< std::map< Key, T, Compare, Allocator > >
+    {
+      typedef std::map< Key, unsigned int, Compare > Type;
+    };
+
+    template< class Key, class T, class Hash, class Equal, class Allocator >
+    struct PersistentContainerCountMap< std::unordered_map< Key, T, Hash, Equal, Allocator > >
+    {
+      typedef std::unordered_map< Key, unsigned int, Hash, Equal > Type;
+    };
+
+  } // namespace Impl
+
+
+
   // PersistentContainerMap
   // ----------------------
 
@@ -87,6 +115,12 @@ namespace Dune
         [ & ]( auto i ){ if( i == this->codimension() ) this->template resize< i >( value ); } );
     }
 
+    template< class Entity >
+    void postRefinement ( const Entity &father, const Value &value = Value() );
+
+    template< class Entity >
+    void preCoarsening ( const Entity &father );
+
     void shrinkToFit () {}
 
     void fill ( const Value &value ) { std::fill( begin(), end(), value ); }
@@ -97,6 +131,7 @@ namespace Dune
       std::swap( codim_, other.codim_ );
       std::swap( idSet_, other.idSet_ );
       std::swap( data_, other.data_ );
+      std::swap( counts_, other.counts_ );
     }
 
     ConstIterator begin () const;
@@ -124,12 +159,18 @@ namespace Dune
     static void migrateEntry ( const typename IdSet::IdType &id, const Value &value,
                                Map &oldData, Map &newData );
 
+    void countSubEntities ();
+
     const IdSet &idSet () const { return *idSet_; }
 
     const Grid *grid_;
     int codim_;
     const IdSet *idSet_;
     Map data_;
+
+    // for codim > 0: number of elements of the hierarchy containing each id,
+    // built by preCoarsening and kept up to date by postRefinement, empty if unknown
+    typename Impl::PersistentContainerCountMap< Map >::Type counts_;
   };
 
 
@@ -208,6 +249,9 @@ namespace Dune
     Map data;
     std::swap( data, data_ );
 
+    // the counts are rebuilt on the next call to preCoarsening
+    counts_.clear();
+
     // copy all data from old map into new one (adding new entries, if necessary)
     const int maxLevel = grid().maxLevel();
     for ( int level = 0; level <= maxLevel; ++level )
@@ -215,6 +259,71 @@ namespace Dune
   }
 
 
+  template< class G, class IdSet, class Map >
+  template< class Entity >
+  inline void PersistentContainerMap< G, IdSet, Map >
+  ::postRefinement ( const Entity &father, const Value &value )
+  {
+    typedef typename Entity::HierarchicIterator HierarchicIterator;
+
+    // insert entries for the children (or their subentities), keep existing ones
+    const int childLevel = father.level() + 1;
+    const HierarchicIterator end = father.hend( childLevel );
+    for( HierarchicIterator it = father.hbegin( childLevel ); it != end; ++it )
+    {
+      if( codimension() == 0 )
+        data_.insert( std::make_pair( idSet().id( *it ), value ) );
+      else
+      {
+        const int subEntities = it->subEntities( codimension() );
+        for( int i = 0; i < subEntities; ++i )
+        {
+          const typename IdSet::IdType id = idSet().subId( *it, i, codimension() );
+          data_.insert( std::make_pair( id, value ) );
+          if( !counts_.empty() )
+            ++counts_[ id ];
+        }
+      }
+    }
+  }
+
+
+  template< class G, class IdSet, class Map >
+  template< class Entity >
+  inline void PersistentContainerMap< G, IdSet, Map >
+  ::preCoarsening ( const Entity &father )
+  {
+    typedef typename Entity::HierarchicIterator HierarchicIterator;
+
+    // subentities of the children might be shared with other elements, so their
+    // entries are only removed once no element of the hierarchy contains them
+    if( (codimension() != 0) && counts_.empty() )
+      countSubEntities();
+
+    const int childLevel = father.level() + 1;
+    const HierarchicIterator end = father.hend( childLevel );
+    for( HierarchicIterator it = father.hbegin( childLevel ); it != end; ++it )
+    {
+      if( codimension() == 0 )
+        data_.erase( idSet().id( *it ) );
+      else
+      {
+        const int subEntities = it->subEntities( codimension() );
+        for( int i = 0; i < subEntities; ++i )
+        {
+          const typename IdSet::IdType id = idSet().subId( *it, i, codimension() );
+          const auto count = counts_.find( id );
+          if( (count != counts_.end()) && (--count->second == 0) )
+          {
+            counts_.erase( count );
+            data_.erase( id );
+          }
+        }
+      }
+    }
+  }
+
+
   template< class G, class IdSet, class Map >
   template< int codim >
   inline void PersistentContainerMap< G, IdSet, Map >
@@ -252,6 +361,27 @@ namespace Dune
   }
 
 
+  template< class G, class IdSet, class Map >
+  inline void PersistentContainerMap< G, IdSet, Map >::countSubEntities ()
+  {
+    typedef typename Grid::LevelGridView LevelView;
+    typedef typename LevelView::template Codim< 0 >::Iterator LevelIterator;
+
+    const int maxLevel = grid().maxLevel();
+    for( int level = 0; level <= maxLevel; ++level )
+    {
+      const LevelView levelView = grid().levelGridView( level );
+      const LevelIterator end = levelView.template end< 0 >();
+      for( LevelIterator it = levelView.template begin< 0 >(); it != end; ++it )
+      {
+        const int subEntities = it->subEntities( codimension() );
+        for( int i = 0; i < subEntities; ++i )
+          ++counts_[ idSet().subId( *it, i, codimension() ) ];
+      }
+    }
+  }
+
+
   template< class G, class IdSet, class Map >
   inline void PersistentContainerMap< G, IdSet, Map >
   ::migrateEntry ( const typename IdSet::IdType &id, const Value &value,
@@ -108,6 +108,15 @@ namespace Dune
       data_.resize( indexSetSize, value );
     }
 
+    template< class Entity >
+    void postRefinement ( const Entity &, const Value &value = Value() )
+    {
+      resize( value );
+    }
+
+    template< class Entity >
+    void preCoarsening ( const Entity & ) {}
+
     void shrinkToFit () {}
 
     void fill ( const Value &value ) { std::fill( begin(), end(), value ); }
@@ -64,6 +64,18 @@ namespace Dune
     void resize ( const Value &value = Value() ) { hostContainer_.resize( value ); }
     void shrinkToFit () { return hostContainer_.shrinkToFit(); }
 
+    template< class Entity >
+    void postRefinement ( const Entity &father, const Value &value = Value() )
+    {
+      hostContainer_.postRefinement( HostGridAccess::hostEntity( father ), value );
+    }
+
+    template< class Entity >
+    void preCoarsening ( const Entity &father )
+    {
+      hostContainer_.preCoarsening( HostGridAccess::hostEntity( father ) );
+    }
+
     void fill ( const Value &value = Value() ) { hostContainer_.fill( value ); }
 
     void swap ( This &other ) { hostContainer_.swap( other.hostContainer_ ); }
@@ -2,10 +2,16 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include "config.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <numeric>
+#include <string>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
+#include <dune/common/timer.hh>
 
 #include <dune/grid/yaspgrid.hh>
 #include <dune/grid/uggrid.hh>
@@ -63,15 +69,87 @@ void checkIndexSet(const GridView& gridView,
   indicesGlobal.erase(last, indicesGlobal.end());
 
   if (gridView.comm().rank()==0)
+  {
     for (size_t i=0; i<indicesGlobal.size(); i++)
       if ( indicesGlobal[i] != i )
         DUNE_THROW(Exception, i << "th global index is not " << i);
 
+    if (indicesGlobal.size() != indexSet.size(codim))
+      DUNE_THROW(Exception, "GlobalIndexSet has size " << indexSet.size(codim) << ", but "
+                 << indicesGlobal.size() << " different indices");
+  }
+
+}
+
+/** \brief Create a GlobalIndexSet, check it and report the time of its construction
+ *
+ * The reported time is the maximum over all processes.  Calling the test with
+ * increasing numbers of processes shows how the construction scales.
+ */
+template <class GridView, int codim>
+void testIndexSet(const GridView& gridView, const std::string& name)
+{
+  Timer watch;
+  GlobalIndexSet<GridView> indexSet(gridView,codim);
+  const double time = gridView.comm().max(watch.elapsed());
+
+  if (gridView.comm().rank() == 0)
+    std::cout << name << ": " << indexSet.size(codim) << " entities on " << gridView.comm().size()
+              << " processes, constructed in " << time << " s" << std::endl;
+  checkIndexSet<GridView,codim>(gridView, indexSet);
+}
+
+/** \brief Distribute a grid that lives on the root process, carrying a GlobalIndexSet along
+ *
+ * After the update, the index set is checked for consistency.  If the grid migrates
+ * the data of the codimension, every entity has to keep its global index, which is
+ * checked by comparing the centers of the entities before and after load balancing.
+ */
+template <class Grid, int codim>
+void testLoadBalance(Grid& grid, const std::string& name, bool stable)
+{
+  typedef typename Grid::LeafGridView GridView;
+  static const int dimworld = Grid::dimensionworld;
+  const GridView gridView = grid.leafGridView();
+
+  GlobalIndexSet<GridView> indexSet(gridView,codim);
+
+  // Before load balancing, the root process knows all entities
+  std::vector<double> centers(dimworld*indexSet.size(codim));
+  for (const auto& element : elements(gridView))
+    for (size_t i=0; i<element.subEntities(codim); i++) {
+      const auto center = element.template subEntity<codim>(i).geometry().center();
+      std::copy(center.begin(), center.end(), centers.begin() + dimworld*indexSet.subIndex(element, i, codim));
+    }
+  gridView.comm().broadcast(centers.data(), centers.size(), 0);
+
+  Timer watch;
+  auto handle = indexSet.loadBalanceHandle();
+  grid.loadBalance(handle);
+  indexSet.update(handle);
+  const double time = gridView.comm().max(watch.elapsed());
+
+  if (gridView.comm().rank() == 0)
+    std::cout << name << ": load balanced and updated in " << time << " s" << std::endl;
+  checkIndexSet<GridView,codim>(gridView, indexSet);
+
+  if (!stable)
+    return;
+
+  for (const auto& element : elements(gridView))
+    for (size_t i=0; i<element.subEntities(codim); i++) {
+      const auto center = element.template subEntity<codim>(i).geometry().center();
+      const auto index = indexSet.subIndex(element, i, codim);
+      for (int k=0; k<dimworld; k++)
+        if (std::abs(center[k] - centers[dimworld*index + k]) > 1e-10)
+          DUNE_THROW(Exception, name << ": entity at " << center << " changed its global index " << index
+                     << " during load balancing");
+    }
 }
 
 int main(int argc, char* argv[]) try
 {
-  Dune::MPIHelper& mpiHelper = MPIHelper::instance(argc, argv);
+  MPIHelper::instance(argc, argv);
 
   ////////////////////////////////////////////////////
   //  Create a distributed YaspGrid
@@ -97,7 +175,8 @@ int main(int argc, char* argv[]) try
 #if HAVE_UG
   typedef UGGrid<dim> GridType;
 
-  std::array<unsigned int,dim> elements = { {8, 8} };
+  const unsigned int n = (argc > 1) ? std::atoi(argv[1]) : 8;
+  std::array<unsigned int,dim> elements = { {n, n} };
   FieldVector<double,dim> lower = {0, 0};
   FieldVector<double,dim> bbox = {10, 10};
 
@@ -112,23 +191,19 @@ int main(int argc, char* argv[]) try
   //  Create and check global index sets
   /////////////////////////////////////////////////////
 
-  // elements
-  if (mpiHelper.rank() == 0)
-    std::cout << "Elements" << std::endl;
-  GlobalIndexSet<GridView> elementIndexSet(gridView,0);
-  checkIndexSet<GridView,0>(gridView, elementIndexSet);
-
-  // edges
-  if (mpiHelper.rank() == 0)
-    std::cout << "Edges" << std::endl;
-  GlobalIndexSet<GridView> edgeIndexSet(gridView,1);
-  checkIndexSet<GridView,1>(gridView, edgeIndexSet);
-
-  // vertices
-  if (mpiHelper.rank() == 0)
-    std::cout << "Vertices" << std::endl;
-  GlobalIndexSet<GridView> vertexIndexSet(gridView,2);
-  checkIndexSet<GridView,2>(gridView, vertexIndexSet);
+  testIndexSet<GridView,0>(gridView, "Elements");
+  testIndexSet<GridView,1>(gridView, "Edges");
+  testIndexSet<GridView,2>(gridView, "Vertices");
+
+  /////////////////////////////////////////////////////
+  //  Carry global index sets through load balancing
+  /////////////////////////////////////////////////////
+
+  // UGGrid migrates the data of elements and vertices only.  The edges are
+  // renumbered if the index set cannot be updated otherwise.
+  testLoadBalance<GridType,0>(*StructuredGridFactory<GridType>::createCubeGrid(lower, bbox, elements), "Elements", true);
+  testLoadBalance<GridType,1>(*StructuredGridFactory<GridType>::createCubeGrid(lower, bbox, elements), "Edges", false);
+  testLoadBalance<GridType,2>(*StructuredGridFactory<GridType>::createCubeGrid(lower, bbox, elements), "Vertices", true);
 #endif
 
   return 0;
@@ -6,12 +6,24 @@
 
 #include <config.h>
 
+#include <array>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
+#include <map>
+#include <set>
+#include <string>
 
 #include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/grid/onedgrid.hh>
 #include <dune/grid/yaspgrid.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
 
 #include <dune/grid/utility/persistentcontainer.hh>
+#include <dune/grid/utility/persistentcontainermap.hh>
 #include <dune/grid/utility/structuredgridfactory.hh>
 
 using namespace Dune;
@@ -126,6 +138,156 @@ bool test(GridType &grid)
   return ret;
 }
 
+/** \brief Refine and coarsen all leaf elements several times, carrying the element volumes along
+
+   The volumes are prolongated to the children and restricted to the fathers
+   through the container.  With incremental updates, the container is adapted
+   by postRefinement and preCoarsening for the refined and coarsened elements
+   instead of resize.  Returns the time spent in the container, i.e., in
+   updating it and in the data accesses.
+ */
+template <class Container, class GridType>
+double adaptationCycles(GridType &grid, int cycles, int refinements, bool incremental)
+{
+  const auto view = grid.leafGridView();
+  Container container(grid, 0, -1.0);
+  Timer watch(false);
+
+  watch.start();
+  for (const auto &element : elements(view))
+    container[element] = element.geometry().volume();
+  watch.stop();
+
+  for (int cycle = 0; cycle < cycles; ++cycle)
+  {
+    for (int i = 0; i < refinements; ++i)
+    {
+      for (const auto &element : elements(view))
+        grid.mark(1, element);
+      grid.preAdapt();
+      grid.adapt();
+
+      // all elements of the previous finest level have been refined
+      watch.start();
+      if (incremental)
+        for (const auto &father : elements(grid.levelGridView(grid.maxLevel()-1)))
+          container.postRefinement(father, -1.0);
+      else
+        container.resize();
+      for (const auto &element : elements(view))
+      {
+        if (!element.isNew())
+          continue;
+        const auto father = element.father();
+        container[element] = container[father] * element.geometry().volume() / father.geometry().volume();
+      }
+      watch.stop();
+      grid.postAdapt();
+    }
+
+    for (int i = 0; i < refinements; ++i)
+    {
+      for (const auto &element : elements(view))
+        grid.mark(-1, element);
+      grid.preAdapt();
+
+      watch.start();
+      for (const auto &element : elements(view))
+        if (element.mightVanish())
+          container[element.father()] = 0.0;
+      for (const auto &element : elements(view))
+        if (element.mightVanish())
+          container[element.father()] += container[element];
+      if (incremental)
+        for (const auto &father : elements(grid.levelGridView(grid.maxLevel()-1)))
+          container.preCoarsening(father);
+      watch.stop();
+
+      grid.adapt();
+      if (!incremental)
+      {
+        watch.start();
+        container.resize();
+        watch.stop();
+      }
+      grid.postAdapt();
+    }
+
+    for (const auto &element : elements(view))
+      if (std::abs(container[element] - element.geometry().volume()) > 1e-10)
+        DUNE_THROW(GridError, "Wrong data stored in the container after " << cycle+1 << " adaptation cycles");
+  }
+  return watch.elapsed();
+}
+
+/** \brief Refine and coarsen the grid, updating a vertex container incrementally
+
+   After each adaptation step, the container must have as many entries as a
+   newly created one, i.e., preCoarsening removes the entries of the vanishing
+   vertices, but not those shared with remaining elements.  If local is true,
+   only every other leaf element is refined.
+ */
+template <class Container, class GridType>
+void checkVertexEntries(GridType &grid, int refinements, bool local)
+{
+  const int dim = GridType::dimension;
+  const auto view = grid.leafGridView();
+  const auto &idSet = grid.localIdSet();
+  Container container(grid, dim, 0.0);
+
+  for (int i = 0; i < 2*refinements; ++i)
+  {
+    const bool refine = (i < refinements);
+    int count = 0;
+    for (const auto &element : elements(view))
+      if (!refine)
+        grid.mark(-1, element);
+      else if (!local || (count++ % 2 == 0))
+        grid.mark(1, element);
+    grid.preAdapt();
+
+    std::set<typename GridType::LocalIdSet::IdType> fathers;
+    if (!refine)
+      for (const auto &element : elements(view))
+        if (element.mightVanish() && fathers.insert(idSet.id(element.father())).second)
+          container.preCoarsening(element.father());
+    grid.adapt();
+    if (refine)
+      for (const auto &element : elements(view))
+        if (element.isNew() && fathers.insert(idSet.id(element.father())).second)
+          container.postRefinement(element.father(), 0.0);
+    grid.postAdapt();
+
+    const Container reference(grid, dim, 0.0);
+    if (container.size() != reference.size())
+      DUNE_THROW(GridError, "Vertex container has " << container.size() << " entries after "
+                 << (refine ? "refinement" : "coarsening") << " instead of " << reference.size());
+  }
+}
+
+//! the std::map based default implementation of the PersistentContainer
+template <class GridType>
+struct DefaultContainer
+  : public PersistentContainerMap<GridType, typename GridType::LocalIdSet, std::map<typename GridType::LocalIdSet::IdType, double> >
+{
+  typedef PersistentContainerMap<GridType, typename GridType::LocalIdSet, std::map<typename GridType::LocalIdSet::IdType, double> > Base;
+
+  DefaultContainer(const GridType &grid, int codim, double value)
+    : Base(grid, codim, grid.localIdSet(), value)
+  {}
+};
+
+//! compare the PersistentContainer of a grid with the map-based default
+template <class GridType>
+void benchmark(GridType &grid, const std::string &name, int cycles, int refinements)
+{
+  std::cout << "Adaptation cycles for " << name << " with " << grid.leafGridView().size(0) << " macro elements:" << std::endl;
+  std::cout << "  PersistentContainer, resize:              " << adaptationCycles<PersistentContainer<GridType, double> >(grid, cycles, refinements, false) << " s" << std::endl;
+  std::cout << "  PersistentContainer, incremental:         " << adaptationCycles<PersistentContainer<GridType, double> >(grid, cycles, refinements, true) << " s" << std::endl;
+  std::cout << "  std::map based default, resize:           " << adaptationCycles<DefaultContainer<GridType> >(grid, cycles, refinements, false) << " s" << std::endl;
+  std::cout << "  std::map based default, incremental:      " << adaptationCycles<DefaultContainer<GridType> >(grid, cycles, refinements, true) << " s" << std::endl;
+}
+
 int main (int argc , char **argv)
 try {
 
@@ -146,6 +308,27 @@ try {
     test(grid);
   }
 
+  // /////////////////////////////////////////////////////////////////////////////
+  //   Refine and coarsen OneDGrid and UGGrid
+  // /////////////////////////////////////////////////////////////////////////////
+  const int cycles = (argc > 1) ? std::atoi(argv[1]) : 3;
+  const int refinements = (argc > 2) ? std::atoi(argv[2]) : 3;
+  {
+    OneDGrid grid(1000, 0.0, 1.0);
+    benchmark(grid, "OneDGrid", cycles, refinements);
+    checkVertexEntries<PersistentContainer<OneDGrid, double> >(grid, refinements, true);
+    checkVertexEntries<DefaultContainer<OneDGrid> >(grid, refinements, true);
+  }
+
+#if HAVE_UG
+  {
+    const auto grid = StructuredGridFactory<UGGrid<2> >::createSimplexGrid(FieldVector<double,2>(0.0), FieldVector<double,2>(1.0),
+                                                                           std::array<unsigned int,2>{ {30, 30} });
+    benchmark(*grid, "UGGrid<2>", cycles, refinements);
+    checkVertexEntries<PersistentContainer<UGGrid<2>, double> >(*grid, refinements, false);
+  }
+#endif
+
   return 0;
 }
 catch (Exception &e) {
@@ -77,6 +77,7 @@ namespace Dune {
 #include <dune/grid/yaspgrid/yaspgridhierarchiciterator.hh>
 #include <dune/grid/yaspgrid/yaspgridentityseed.hh>
 #include <dune/grid/yaspgrid/yaspgridleveliterator.hh>
+#include <dune/grid/yaspgrid/yaspgridindexbox.hh>
 #include <dune/grid/yaspgrid/yaspgridindexsets.hh>
 #include <dune/grid/yaspgrid/yaspgrididset.hh>
 #include <dune/grid/yaspgrid/yaspgridpersistentcontainer.hh>
@@ -287,6 +288,44 @@ namespace Dune {
       return keep_ovlp;
     }
 
+    /** \brief return the structured index space of a partition on a grid level
+     *
+     * This is only available for elements and vertices, whose indices form a
+     * single lexicographically ordered array. The indices described by the
+     * box are those of levelIndexSet(level), and of leafIndexSet() on the
+     * finest level. YaspGrid has no ghosts, so for Ghost_Partition the box is empty.
+     *
+     * \param level the grid level
+     * \param codim 0 or dim
+     * \param pitype the partition of the entities in the box
+     */
+    YaspIndexBox<dim> indexBox (int level, int codim, PartitionIteratorType pitype) const
+    {
+      if (codim != 0 && codim != dim)
+        DUNE_THROW(GridError, "YaspGrid::indexBox is only available for codimensions 0 and " << dim);
+
+      YGridLevelIterator g = begin(level);
+
+      const YGrid* yg = 0;
+      if (pitype==Interior_Partition)
+        yg = &g->interior[codim];
+      else if (pitype==InteriorBorder_Partition)
+        yg = &g->interiorborder[codim];
+      else if (pitype==Overlap_Partition)
+        yg = &g->overlap[codim];
+      else if (pitype<=All_Partition)
+        yg = &g->overlapfront[codim];
+      else
+        return YaspIndexBox<dim>();
+
+      // codimensions 0 and dim consist of exactly one component
+      const YGridComponent<Coordinates>& c = *(yg->dataBegin());
+      iTupel stride;
+      for (int i=0; i<dim; i++)
+        stride[i] = c.superincrement(i);
+      return YaspIndexBox<dim>(c.origin(), c.size(), stride, yg->superindex(c.origin(),0));
+    }
+
     //! Iterator over the grid levels
     typedef typename ReservedVector<YGridLevel,32>::const_iterator YGridLevelIterator;
 
@@ -402,6 +441,13 @@ namespace Dune {
         }
       }
 
+      // Without overlap, interiorborder coincides with overlapfront and overlap
+      // coincides with interior. Then all communication lists towards overlapfront
+      // equal the interiorborder_interiorborder lists, and the overlap_overlapfront
+      // lists are empty. In that case only the interiorborder lists are computed
+      // and the other lists share their data.
+      const bool zeroOverlap = (overlap == 0);
+
       for (unsigned int codim = 0; codim < dim + 1; codim++)
       {
         // set the begin iterator for the corresponding ygrids
@@ -409,14 +455,24 @@ namespace Dune {
         g.overlap[codim].setBegin(overlap_it);
         g.interiorborder[codim].setBegin(interiorborder_it);
         g.interior[codim].setBegin(interior_it);
-        g.send_overlapfront_overlapfront[codim].setBegin(send_overlapfront_overlapfront_it);
-        g.recv_overlapfront_overlapfront[codim].setBegin(recv_overlapfront_overlapfront_it);
         g.send_overlap_overlapfront[codim].setBegin(send_overlap_overlapfront_it);
         g.recv_overlapfront_overlap[codim].setBegin(recv_overlapfront_overlap_it);
         g.send_interiorborder_interiorborder[codim].setBegin(send_interiorborder_interiorborder_it);
         g.recv_interiorborder_interiorborder[codim].setBegin(recv_interiorborder_interiorborder_it);
-        g.send_interiorborder_overlapfront[codim].setBegin(send_interiorborder_overlapfront_it);
-        g.recv_overlapfront_interiorborder[codim].setBegin(recv_overlapfront_interiorborder_it);
+        if (zeroOverlap)
+        {
+          g.send_overlapfront_overlapfront[codim].setBegin(send_interiorborder_interiorborder_it);
+          g.recv_overlapfront_overlapfront[codim].setBegin(recv_interiorborder_interiorborder_it);
+          g.send_interiorborder_overlapfront[codim].setBegin(send_interiorborder_interiorborder_it);
+          g.recv_overlapfront_interiorborder[codim].setBegin(recv_interiorborder_interiorborder_it);
+        }
+        else
+        {
+          g.send_overlapfront_overlapfront[codim].setBegin(send_overlapfront_overlapfront_it);
+          g.recv_overlapfront_overlapfront[codim].setBegin(recv_overlapfront_overlapfront_it);
+          g.send_interiorborder_overlapfront[codim].setBegin(send_interiorborder_overlapfront_it);
+          g.recv_overlapfront_interiorborder[codim].setBegin(recv_overlapfront_interiorborder_it);
+        }
 
         // find all combinations of unit vectors that span entities of the given codimension
         for (unsigned int index = 0; index < (1<<dim); index++)
@@ -491,10 +547,13 @@ namespace Dune {
           }
           *interior_it = YGridComponent<Coordinates>(origin, size, *overlapfront_it);
 
-          intersections(*overlapfront_it,*overlapfront_it,*send_overlapfront_overlapfront_it, *recv_overlapfront_overlapfront_it);
-          intersections(*overlap_it,*overlapfront_it,*send_overlap_overlapfront_it, *recv_overlapfront_overlap_it);
           intersections(*interiorborder_it,*interiorborder_it,*send_interiorborder_interiorborder_it,*recv_interiorborder_interiorborder_it);
-          intersections(*interiorborder_it,*overlapfront_it,*send_interiorborder_overlapfront_it,*recv_overlapfront_interiorborder_it);
+          if (!zeroOverlap)
+          {
+            intersections(*overlapfront_it,*overlapfront_it,*send_overlapfront_overlapfront_it, *recv_overlapfront_overlapfront_it);
+            intersections(*overlap_it,*overlapfront_it,*send_overlap_overlapfront_it, *recv_overlapfront_overlap_it);
+            intersections(*interiorborder_it,*overlapfront_it,*send_interiorborder_overlapfront_it,*recv_overlapfront_interiorborder_it);
+          }
 
           // advance all iterators pointing to the next insertion point
           ++overlapfront_it;
@@ -516,14 +575,24 @@ namespace Dune {
         g.overlap[codim].finalize(overlap_it);
         g.interiorborder[codim].finalize(interiorborder_it);
         g.interior[codim].finalize(interior_it);
-        g.send_overlapfront_overlapfront[codim].finalize(send_overlapfront_overlapfront_it,g.overlapfront[codim]);
-        g.recv_overlapfront_overlapfront[codim].finalize(recv_overlapfront_overlapfront_it,g.overlapfront[codim]);
         g.send_overlap_overlapfront[codim].finalize(send_overlap_overlapfront_it,g.overlapfront[codim]);
         g.recv_overlapfront_overlap[codim].finalize(recv_overlapfront_overlap_it,g.overlapfront[codim]);
         g.send_interiorborder_interiorborder[codim].finalize(send_interiorborder_interiorborder_it,g.overlapfront[codim]);
         g.recv_interiorborder_interiorborder[codim].finalize(recv_interiorborder_interiorborder_it,g.overlapfront[codim]);
-        g.send_interiorborder_overlapfront[codim].finalize(send_interiorborder_overlapfront_it,g.overlapfront[codim]);
-        g.recv_overlapfront_interiorborder[codim].finalize(recv_overlapfront_interiorborder_it,g.overlapfront[codim]);
+        if (zeroOverlap)
+        {
+          g.send_overlapfront_overlapfront[codim].finalize(send_interiorborder_interiorborder_it,g.overlapfront[codim]);
+          g.recv_overlapfront_overlapfront[codim].finalize(recv_interiorborder_interiorborder_it,g.overlapfront[codim]);
+          g.send_interiorborder_overlapfront[codim].finalize(send_interiorborder_interiorborder_it,g.overlapfront[codim]);
+          g.recv_overlapfront_interiorborder[codim].finalize(recv_interiorborder_interiorborder_it,g.overlapfront[codim]);
+        }
+        else
+        {
+          g.send_overlapfront_overlapfront[codim].finalize(send_overlapfront_overlapfront_it,g.overlapfront[codim]);
+          g.recv_overlapfront_overlapfront[codim].finalize(recv_overlapfront_overlapfront_it,g.overlapfront[codim]);
+          g.send_interiorborder_overlapfront[codim].finalize(send_interiorborder_overlapfront_it,g.overlapfront[codim]);
+          g.recv_overlapfront_interiorborder[codim].finalize(recv_overlapfront_interiorborder_it,g.overlapfront[codim]);
+        }
       }
     }
 
@@ -757,17 +826,16 @@ namespace Dune {
 
 #if HAVE_MPI
       // check whether the grid is large enough to be overlapping
+      int toosmall = 0;
       for (int i=0; i<dim; i++)
-      {
-        // find out whether the grid is too small to
-        int toosmall = (s_interior[i] <= overlap) &&    // interior is very small
-            (periodic[i] || (s_interior[i] != s[i]));    // there is an overlap in that direction
-        // communicate the result to all those processes to have all processors error out if one process failed.
-        int global = 0;
-        MPI_Allreduce(&toosmall, &global, 1, MPI_INT, MPI_LOR, comm);
-        if (global)
-          DUNE_THROW(Dune::GridError,"YaspGrid is too small to be overlapping");
-      }
+        toosmall = toosmall || ((s_interior[i] <= overlap) &&    // interior is very small
+              (periodic[i] || (s_interior[i] != s[i])));   // there is an overlap in that direction
+      // communicate the result to all those processes to have all processors error out if one process failed.
+      // A single reduction covers all directions.
+      int global = 0;
+      MPI_Allreduce(&toosmall, &global, 1, MPI_INT, MPI_LOR, comm);
+      if (global)
+        DUNE_THROW(Dune::GridError,"YaspGrid is too small to be overlapping");
 #endif // #if HAVE_MPI
 
       fTupel h(L);
@@ -827,17 +895,16 @@ namespace Dune {
 
 #if HAVE_MPI
       // check whether the grid is large enough to be overlapping
+      int toosmall = 0;
       for (int i=0; i<dim; i++)
-      {
-        // find out whether the grid is too small to
-        int toosmall = (s_interior[i] <= overlap) &&    // interior is very small
-            (periodic[i] || (s_interior[i] != s[i]));    // there is an overlap in that direction
-        // communicate the result to all those processes to have all processors error out if one process failed.
-        int global = 0;
-        MPI_Allreduce(&toosmall, &global, 1, MPI_INT, MPI_LOR, comm);
-        if (global)
-          DUNE_THROW(Dune::GridError,"YaspGrid is too small to be overlapping");
-      }
+        toosmall = toosmall || ((s_interior[i] <= overlap) &&    // interior is very small
+              (periodic[i] || (s_interior[i] != s[i])));   // there is an overlap in that direction
+      // communicate the result to all those processes to have all processors error out if one process failed.
+      // A single reduction covers all directions.
+      int global = 0;
+      MPI_Allreduce(&toosmall, &global, 1, MPI_INT, MPI_LOR, comm);
+      if (global)
+        DUNE_THROW(Dune::GridError,"YaspGrid is too small to be overlapping");
 #endif // #if HAVE_MPI
 
       Dune::FieldVector<ctype,dim> extension(upperright);
@@ -905,17 +972,16 @@ namespace Dune {
 
 #if HAVE_MPI
       // check whether the grid is large enough to be overlapping
+      int toosmall = 0;
       for (int i=0; i<dim; i++)
-      {
-        // find out whether the grid is too small to
-        int toosmall = (s_interior[i] <= overlap) &&               // interior is very small
-             (periodic[i] || (s_interior[i] != _coarseSize[i]));    // there is an overlap in that direction
-        // communicate the result to all those processes to have all processors error out if one process failed.
-        int global = 0;
-        MPI_Allreduce(&toosmall, &global, 1, MPI_INT, MPI_LOR, comm);
-        if (global)
-          DUNE_THROW(Dune::GridError,"YaspGrid is too small to be overlapping");
-      }
+        toosmall = toosmall || ((s_interior[i] <= overlap) &&               // interior is very small
+               (periodic[i] || (s_interior[i] != _coarseSize[i])));   // there is an overlap in that direction
+      // communicate the result to all those processes to have all processors error out if one process failed.
+      // A single reduction covers all directions.
+      int global = 0;
+      MPI_Allreduce(&toosmall, &global, 1, MPI_INT, MPI_LOR, comm);
+      if (global)
+        DUNE_THROW(Dune::GridError,"YaspGrid is too small to be overlapping");
 #endif // #if HAVE_MPI
 
 
@@ -1374,6 +1440,30 @@ namespace Dune {
       // define type to iterate over send and recv lists
       typedef typename YGridList<Coordinates>::Iterator ListIt;
 
+      // Messages from this process to itself (periodic directions on a single
+      // process) are not routed through the torus: the receiving side reads the
+      // buffers of the matching send directly, which saves the receive buffers
+      // and the memcpy in Torus::exchange. Local sends and receives are matched
+      // in list order, just as Torus::exchange does.
+      const int myrank = torus().rank();
+      std::vector<int> localsend(recvlist->size(),-1);    // map local recv to the matching send
+      {
+        std::vector<int> localsends;
+        cnt=0;
+        for (ListIt is=sendlist->begin(); is!=sendlist->end(); ++is, ++cnt)
+          if (is->rank==myrank)
+            localsends.push_back(cnt);
+        std::size_t k=0;
+        cnt=0;
+        for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is, ++cnt)
+          if (is->rank==myrank)
+          {
+            assert(k<localsends.size());
+            localsend[cnt] = localsends[k++];
+          }
+        assert(k==localsends.size());
+      }
+
       if (data.fixedSize(dim,codim))
       {
         // fixed size: just take a dummy entity, size can be computed without communication
@@ -1421,7 +1511,8 @@ namespace Dune {
           send_size[cnt] = n;
 
           // hand over send request to torus class
-          torus().send(is->rank,buf,is->grid.totalsize()*sizeof(size_t));
+          if (is->rank!=myrank)
+            torus().send(is->rank,buf,is->grid.totalsize()*sizeof(size_t));
           cnt++;
         }
 
@@ -1429,6 +1520,15 @@ namespace Dune {
         cnt=0;
         for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is)
         {
+          // local messages take over the send buffer
+          if (localsend[cnt]>=0)
+          {
+            recv_sizes[cnt] = send_sizes[localsend[cnt]];
+            send_sizes[localsend[cnt]] = 0;
+            cnt++;
+            continue;
+          }
+
           // allocate recv buffer
           size_t *buf = new size_t[is->grid.totalsize()];
           recv_sizes[cnt] = buf;
@@ -1492,7 +1592,8 @@ namespace Dune {
           data.gather(mb,*it);
 
         // hand over send request to torus class
-        torus().send(is->rank,buf,send_size[cnt]*sizeof(DataType));
+        if (is->rank!=myrank)
+          torus().send(is->rank,buf,send_size[cnt]*sizeof(DataType));
         cnt++;
       }
 
@@ -1501,6 +1602,16 @@ namespace Dune {
       cnt=0;
       for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is)
       {
+        // local messages are scattered directly from the send buffer
+        if (localsend[cnt]>=0)
+        {
+          assert(send_size[localsend[cnt]]==recv_size[cnt]);
+          recvs[cnt] = sends[localsend[cnt]];
+          sends[localsend[cnt]] = 0;
+          cnt++;
+          continue;
+        }
+
         // allocate recv buffer
         DataType *buf = new DataType[recv_size[cnt]];
 
@@ -9,6 +9,7 @@
  */
 
 #include<array>
+#include<vector>
 
 #include<dune/common/power.hh>
 
@@ -50,17 +51,35 @@ namespace Dune
       optimize_dims(d-1,size,P,dims,trydims,opt);
     }
   private:
+    /** \brief Return all divisors of P in ascending order
+     *
+     * Only candidates up to sqrt(P) are tested, so the cost grows with sqrt(P)
+     * instead of P. This matters because every process runs the load balancer.
+     */
+    static std::vector<int> divisors (int P)
+    {
+      std::vector<int> lower, upper;
+      for (int k=1; k*k<=P; k++)
+        if (P%k==0)
+        {
+          lower.push_back(k);
+          if (k != P/k)
+            upper.push_back(P/k);
+        }
+      lower.insert(lower.end(), upper.rbegin(), upper.rend());
+      return lower;
+    }
+
     void optimize_dims (int i, const iTupel& size, int P, iTupel& dims, iTupel& trydims, double &opt ) const
     {
       if (i>0) // test all subdivisions recursively
       {
-        for (int k=1; k<=P; k++)
-          if (P%k==0)
-          {
-            // P divisible by k
-            trydims[i] = k;
-            optimize_dims(i-1,size,P/k,dims,trydims,opt);
-          }
+        for (int k : divisors(P))
+        {
+          // P divisible by k
+          trydims[i] = k;
+          optimize_dims(i-1,size,P/k,dims,trydims,opt);
+        }
       }
       else
       {
@@ -97,7 +116,7 @@ namespace Dune
 
     virtual void loadbalance (const iTupel& size, int P, iTupel& dims) const
     {
-      for(int i=1; i<=P; ++i)
+      for(int i=1; Power<d>::eval(i)<=P; ++i)
         if(Power<d>::eval(i)==P) {
           std::fill(dims.begin(), dims.end(),i);
           return;
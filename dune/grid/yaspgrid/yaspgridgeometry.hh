@@ -47,6 +47,54 @@ namespace Dune {
     YaspGeometry (const YaspGeometry& other)
       : AxisAlignedCubeGeometry<ctype,mydim,cdim>(other)
     {}
+
+    using AxisAlignedCubeGeometry<ctype,mydim,cdim>::global;
+    using AxisAlignedCubeGeometry<ctype,mydim,cdim>::local;
+
+    /** \brief Map a whole set of local coordinates to global coordinates
+     *
+     *  The map is \f$ g(x) = c_0 + \sum_k x_k (c_{2^k} - c_0) \f$, where
+     *  \f$c_i\f$ are the corners. The corners are looked up once and the
+     *  loop over the points carries no dispatch.
+     */
+    template<class LocalContainer, class GlobalContainer>
+    void global (const LocalContainer& local, GlobalContainer& global) const
+    {
+      const FieldVector<ctype,cdim> origin = this->corner(0);
+      FieldVector<ctype,cdim> dir[mydim];
+      for (int k=0; k<mydim; ++k)
+        dir[k] = this->corner(1<<k) - origin;
+
+      const std::size_t n = local.size();
+      for (std::size_t q=0; q<n; ++q)
+      {
+        FieldVector<ctype,cdim> y = origin;
+        for (int k=0; k<mydim; ++k)
+          y.axpy(local[q][k], dir[k]);
+        global[q] = y;
+      }
+    }
+
+    //! Map a whole set of global coordinates to local coordinates
+    template<class GlobalContainer, class LocalContainer>
+    void local (const GlobalContainer& global, LocalContainer& local) const
+    {
+      const FieldVector<ctype,cdim> origin = this->corner(0);
+      FieldVector<ctype,cdim> dir[mydim];
+      for (int k=0; k<mydim; ++k)
+      {
+        dir[k] = this->corner(1<<k) - origin;
+        dir[k] /= dir[k].two_norm2();
+      }
+
+      const std::size_t n = global.size();
+      for (std::size_t q=0; q<n; ++q)
+      {
+        const FieldVector<ctype,cdim> y = global[q] - origin;
+        for (int k=0; k<mydim; ++k)
+          local[q][k] = dir[k] * y;
+      }
+    }
   };
 
   //! specialize for dim=dimworld, i.e. a volume element
@@ -70,6 +118,41 @@ namespace Dune {
     YaspGeometry (const YaspGeometry& other)
       : AxisAlignedCubeGeometry<ctype,mydim,mydim>(other)
     {}
+
+    using AxisAlignedCubeGeometry<ctype,mydim,mydim>::global;
+    using AxisAlignedCubeGeometry<ctype,mydim,mydim>::local;
+
+    /** \brief Map a whole set of local coordinates to global coordinates
+     *
+     *  For volume elements the map is diagonal, so every coordinate direction
+     *  is a plain scaled shift that the compiler can vectorize over the points.
+     */
+    template<class LocalContainer, class GlobalContainer>
+    void global (const LocalContainer& local, GlobalContainer& global) const
+    {
+      const FieldVector<ctype,mydim> lower = this->corner(0);
+      const FieldVector<ctype,mydim> h = this->corner((1<<mydim)-1) - lower;
+
+      const std::size_t n = local.size();
+      for (std::size_t q=0; q<n; ++q)
+        for (int i=0; i<mydim; ++i)
+          global[q][i] = lower[i] + h[i]*local[q][i];
+    }
+
+    //! Map a whole set of global coordinates to local coordinates
+    template<class GlobalContainer, class LocalContainer>
+    void local (const GlobalContainer& global, LocalContainer& local) const
+    {
+      const FieldVector<ctype,mydim> lower = this->corner(0);
+      FieldVector<ctype,mydim> invh;
+      for (int i=0; i<mydim; ++i)
+        invh[i] = 1.0 / (this->corner((1<<mydim)-1)[i] - lower[i]);
+
+      const std::size_t n = global.size();
+      for (std::size_t q=0; q<n; ++q)
+        for (int i=0; i<mydim; ++i)
+          local[q][i] = (global[q][i] - lower[i]) * invh[i];
+    }
   };
 
   //! specialization for dim=0, this is a vertex
@@ -0,0 +1,152 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_YASPGRIDINDEXBOX_HH
+#define DUNE_GRID_YASPGRIDINDEXBOX_HH
+
+#include <array>
+
+/** \file
+ * \brief Entity-free description of the index space of a YaspGrid level
+
+   A YaspIndexBox describes the entities of one partition of a YaspGrid level
+   as a box in the structured index space, together with the linear map from
+   structured coordinates to the indices of the YaspIndexSet. This allows to
+   write stencil loops directly on flat arrays ordered by the index set,
+   without constructing any entities:
+
+   \code
+   const auto box = grid.indexBox(level, 0, Dune::Interior_Partition);
+   std::array<int,2> c;
+   for (c[1]=box.min(1); c[1]<=box.max(1); ++c[1])
+   {
+     int i = box.index({box.min(0), c[1]});
+     for (c[0]=box.min(0); c[0]<=box.max(0); ++c[0], i+=box.stride(0))
+       u_new[i] = u[i-box.stride(0)] + u[i+box.stride(0)] + u[i-box.stride(1)] + u[i+box.stride(1)];
+   }
+   \endcode
+
+   Since the indices are those of the index set, such arrays can still be
+   communicated with the usual data handles.
+ */
+
+namespace Dune {
+
+  /** \brief A box of entities in the structured index space of a YaspGrid level
+   *
+   * \tparam dim the dimension of the grid
+   */
+  template<int dim>
+  class YaspIndexBox
+  {
+  public:
+    typedef std::array<int, dim> iTupel;
+
+    //! make an empty box
+    YaspIndexBox ()
+      : _offset(0)
+    {
+      _origin.fill(0);
+      _size.fill(0);
+      _stride.fill(0);
+    }
+
+    /** \brief make a box
+     *  \param origin structured coordinate of the first entity in the box
+     *  \param size number of entities in each direction
+     *  \param stride increment of the index for a step in each direction
+     *  \param offset index of the entity at origin
+     */
+    YaspIndexBox (const iTupel& origin, const iTupel& size, const iTupel& stride, int offset)
+      : _origin(origin), _size(size), _stride(stride), _offset(offset)
+    {}
+
+    //! return the structured coordinate of the first entity in direction i
+    int min (int i) const
+    {
+      return _origin[i];
+    }
+
+    //! return the structured coordinate of the last entity in direction i
+    int max (int i) const
+    {
+      return _origin[i] + _size[i] - 1;
+    }
+
+    //! return the structured coordinate of the first entity
+    const iTupel& origin () const
+    {
+      return _origin;
+    }
+
+    //! return the number of entities in direction i
+    int size (int i) const
+    {
+      return _size[i];
+    }
+
+    //! return the number of entities in each direction
+    const iTupel& size () const
+    {
+      return _size;
+    }
+
+    //! return the total number of entities in the box
+    int totalsize () const
+    {
+      int s = 1;
+      for (int i=0; i<dim; ++i)
+        s *= _size[i];
+      return s;
+    }
+
+    //! return true if the box contains no entities
+    bool empty () const
+    {
+      return totalsize() == 0;
+    }
+
+    //! return the increment of the index for a step in direction i
+    int stride (int i) const
+    {
+      return _stride[i];
+    }
+
+    //! return the increments of the index for a step in each direction
+    const iTupel& stride () const
+    {
+      return _stride;
+    }
+
+    //! return true if the given structured coordinate lies in the box
+    bool inside (const iTupel& coord) const
+    {
+      for (int i=0; i<dim; ++i)
+        if (coord[i] < min(i) || coord[i] > max(i))
+          return false;
+      return true;
+    }
+
+    /** \brief return the index set index of the entity at the given structured coordinate
+     *
+     * The coordinate need not lie inside the box, it only has to lie inside
+     * the local grid of the process (including overlap), e.g., a stencil
+     * neighbor of an interior entity.
+     */
+    int index (const iTupel& coord) const
+    {
+      int idx = _offset;
+      for (int i=0; i<dim; ++i)
+        idx += (coord[i] - _origin[i]) * _stride[i];
+      return idx;
+    }
+
+  private:
+    iTupel _origin;
+    iTupel _size;
+    iTupel _stride;
+    int _offset;
+  };
+
+}  // namespace Dune
+
+#endif  // DUNE_GRID_YASPGRIDINDEXBOX_HH